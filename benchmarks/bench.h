@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace bench {
+
+//------------------------------------------------------------------------
+using bench_func = void (*) ();
+
+//------------------------------------------------------------------------
+inline std::vector<std::pair<const char*, bench_func>>& registry ()
+{
+	static std::vector<std::pair<const char*, bench_func>> benchmarks;
+	return benchmarks;
+}
+
+//------------------------------------------------------------------------
+struct registrar
+{
+	registrar (const char* name, bench_func func) { registry ().emplace_back (name, func); }
+};
+
+//------------------------------------------------------------------------
+/** prevent the compiler from optimizing the value away */
+template<typename T>
+inline void do_not_optimize (T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile ("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+//------------------------------------------------------------------------
+/** returns the best time of several runs in nanoseconds per iteration */
+template<typename Proc>
+inline double measure (size_t iterations, Proc proc, size_t runs = 5)
+{
+	using clock = std::chrono::steady_clock;
+	double best = 0.;
+	for (size_t run = 0u; run < runs; ++run)
+	{
+		auto start = clock::now ();
+		for (size_t i = 0u; i < iterations; ++i)
+			proc ();
+		auto duration = std::chrono::duration<double, std::nano> (clock::now () - start).count ();
+		auto ns = duration / static_cast<double> (iterations);
+		best = run == 0u ? ns : std::min (best, ns);
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+/** print the result of a benchmark compared to a baseline */
+inline void report (const char* name, double baseline_ns, double ns)
+{
+	std::printf ("  %-40s %12.2f ns %12.2f ns %8.2fx\n", name, baseline_ns, ns,
+				 ns > 0. ? baseline_ns / ns : 0.);
+}
+
+//------------------------------------------------------------------------
+/** print the column header for report */
+inline void report_header (const char* baseline_name, const char* name)
+{
+	std::printf ("  %-40s %15s %15s %9s\n", "", baseline_name, name, "speedup");
+}
+
+//------------------------------------------------------------------------
+} // bench
+} // vst3utils
+
+//------------------------------------------------------------------------
+#define VST3UTILS_BENCHMARK(name)                                                                  \
+	static void name ();                                                                           \
+	static vst3utils::bench::registrar name##_registrar (#name, name);                             \
+	static void name ()
@@ -0,0 +1,25 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "bench.h"
+#include <cstring>
+
+//------------------------------------------------------------------------
+/** runs all benchmarks or only those whose name contains the first argument */
+int main (int argc, char* argv[])
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+	for (const auto& [name, func] : vst3utils::bench::registry ())
+	{
+		if (filter && std::strstr (name, filter) == nullptr)
+			continue;
+		std::printf ("%s\n", name);
+		func ();
+	}
+	return 0;
+}
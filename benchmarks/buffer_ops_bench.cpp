@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "bench.h"
+#include "vst3utils/buffer_ops.h"
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+constexpr size_t num_samples = 512u;
+constexpr size_t iterations = 100000u;
+
+//------------------------------------------------------------------------
+template<typename T>
+void run_buffer_ops_bench (const char* type_name)
+{
+	multichannel_buffer<T> in (2, num_samples);
+	multichannel_buffer<T> out (2, num_samples);
+	aligned_buffer<T, 64> interleaved (2 * num_samples);
+	in.fill (static_cast<T> (0.5));
+	out.clear ();
+
+	auto src = in[0];
+	auto dst = out[0];
+	const auto gain = static_cast<T> (0.7);
+
+	std::printf (" %s, %zu samples\n", type_name, num_samples);
+	bench::report_header ("naive", "buffer_ops");
+
+	auto naive = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = src[i] * gain;
+		bench::do_not_optimize (dst);
+	});
+	auto ops = bench::measure (iterations, [&] () {
+		apply_gain (src, dst, num_samples, gain);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("apply_gain", naive, ops);
+
+	naive = bench::measure (iterations, [&] () {
+		auto delta = (static_cast<T> (1) - gain) / static_cast<T> (num_samples);
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = src[i] * (gain + static_cast<T> (i) * delta);
+		bench::do_not_optimize (dst);
+	});
+	ops = bench::measure (iterations, [&] () {
+		apply_gain_ramp (src, dst, num_samples, gain, static_cast<T> (1));
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("apply_gain_ramp", naive, ops);
+
+	naive = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] += src[i] * gain;
+		bench::do_not_optimize (dst);
+	});
+	ops = bench::measure (iterations, [&] () {
+		mix (src, dst, num_samples, gain);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("mix", naive, ops);
+
+	naive = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = src[i];
+		bench::do_not_optimize (dst);
+	});
+	ops = bench::measure (iterations, [&] () {
+		copy (src, dst, num_samples);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("copy", naive, ops);
+
+	naive = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = static_cast<T> (0);
+		bench::do_not_optimize (dst);
+	});
+	ops = bench::measure (iterations, [&] () {
+		clear (dst, num_samples);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("clear", naive, ops);
+
+	auto planar_in = in.channels ();
+	auto planar_out = out.channels ();
+	auto inter = interleaved.data ();
+	naive = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+		{
+			for (size_t c = 0u; c < 2u; ++c)
+				inter[i * 2u + c] = planar_in[c][i];
+		}
+		bench::do_not_optimize (inter);
+	});
+	ops = bench::measure (iterations, [&] () {
+		interleave (planar_in, inter, 2u, num_samples);
+		bench::do_not_optimize (inter);
+	});
+	bench::report ("interleave (stereo)", naive, ops);
+
+	naive = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+		{
+			for (size_t c = 0u; c < 2u; ++c)
+				planar_out[c][i] = inter[i * 2u + c];
+		}
+		bench::do_not_optimize (planar_out);
+	});
+	ops = bench::measure (iterations, [&] () {
+		deinterleave (inter, planar_out, 2u, num_samples);
+		bench::do_not_optimize (planar_out);
+	});
+	bench::report ("deinterleave (stereo)", naive, ops);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+VST3UTILS_BENCHMARK (buffer_ops)
+{
+	run_buffer_ops_bench<float> ("float");
+	run_buffer_ops_bench<double> ("double");
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
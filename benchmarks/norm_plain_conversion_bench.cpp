@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "bench.h"
+#include "vst3utils/norm_plain_conversion.h"
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+constexpr size_t num_samples = 512u;
+constexpr size_t iterations = 2000u;
+
+//------------------------------------------------------------------------
+template<typename T>
+void run_exp_mapping_bench (const char* type_name)
+{
+	const auto min = static_cast<T> (20);
+	const auto max = static_cast<T> (20000);
+	aligned_buffer<T, 64> normalized (num_samples);
+	aligned_buffer<T, 64> plain (num_samples);
+	aligned_buffer<T, 64> out (num_samples);
+	for (size_t i = 0u; i < num_samples; ++i)
+		normalized[i] = static_cast<T> (i) / static_cast<T> (num_samples - 1);
+	normalized_to_exp (min, max, normalized.data (), plain.data (), num_samples);
+
+	exp_mapping<T> mapping (min, max);
+	auto src = normalized.data ();
+	auto dst = out.data ();
+
+	std::printf (" %s, %zu values per iteration\n", type_name, num_samples);
+	bench::report_header ("free function", "exp_mapping");
+
+	auto baseline = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = normalized_to_exp (min, max, src[i]);
+		bench::do_not_optimize (dst);
+	});
+	auto mapped = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = mapping.to_plain (src[i]);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("to_plain", baseline, mapped);
+	mapped = bench::measure (iterations, [&] () {
+		mapping.to_plain (src, dst, num_samples);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("to_plain (simd batch)", baseline, mapped);
+
+	src = plain.data ();
+	baseline = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = exp_to_normalized (min, max, src[i]);
+		bench::do_not_optimize (dst);
+	});
+	mapped = bench::measure (iterations, [&] () {
+		for (size_t i = 0u; i < num_samples; ++i)
+			dst[i] = mapping.to_normalized (src[i]);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("to_normalized", baseline, mapped);
+	mapped = bench::measure (iterations, [&] () {
+		mapping.to_normalized (src, dst, num_samples);
+		bench::do_not_optimize (dst);
+	});
+	bench::report ("to_normalized (simd batch)", baseline, mapped);
+}
+
+//------------------------------------------------------------------------
+/** a meter bank converting the peak gains of 64 channels to dB once per block */
+void run_meter_bank_bench ()
+{
+	constexpr size_t num_channels = 64u;
+	constexpr size_t num_blocks = 64u;
+	aligned_buffer<float, 64> peaks (num_channels * num_blocks);
+	aligned_buffer<float, 64> db (num_channels);
+	for (size_t i = 0u; i < peaks.size (); ++i)
+		peaks[i] = static_cast<float> (i + 1u) / static_cast<float> (peaks.size ());
+	auto dst = db.data ();
+
+	std::printf (" meter bank, %zu channels, %zu blocks per iteration\n", num_channels,
+				 num_blocks);
+	bench::report_header ("gain_to_db", "batch");
+
+	auto baseline = bench::measure (iterations, [&] () {
+		for (size_t block = 0u; block < num_blocks; ++block)
+		{
+			auto src = peaks.data () + block * num_channels;
+			for (size_t c = 0u; c < num_channels; ++c)
+				dst[c] = gain_to_db (src[c]);
+			bench::do_not_optimize (dst);
+		}
+	});
+	auto exact = bench::measure (iterations, [&] () {
+		for (size_t block = 0u; block < num_blocks; ++block)
+		{
+			gain_to_db (peaks.data () + block * num_channels, dst, num_channels);
+			bench::do_not_optimize (dst);
+		}
+	});
+	bench::report ("exact", baseline, exact);
+	auto hundredth = bench::measure (iterations, [&] () {
+		for (size_t block = 0u; block < num_blocks; ++block)
+		{
+			gain_to_db<db_precision::hundredth_db> (peaks.data () + block * num_channels, dst,
+													 num_channels);
+			bench::do_not_optimize (dst);
+		}
+	});
+	bench::report ("0.01 dB", baseline, hundredth);
+	auto tenth = bench::measure (iterations, [&] () {
+		for (size_t block = 0u; block < num_blocks; ++block)
+		{
+			gain_to_db<db_precision::tenth_db> (peaks.data () + block * num_channels, dst,
+												 num_channels);
+			bench::do_not_optimize (dst);
+		}
+	});
+	bench::report ("0.1 dB", baseline, tenth);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+VST3UTILS_BENCHMARK (norm_plain_conversion)
+{
+	run_exp_mapping_bench<float> ("float");
+	run_exp_mapping_bench<double> ("double");
+	run_meter_bank_bench ();
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
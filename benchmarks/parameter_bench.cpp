@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "bench.h"
+#include "vst3utils/parameter.h"
+#include <memory>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+constexpr size_t num_parameters = 10000u;
+constexpr size_t iterations = 50u;
+
+//------------------------------------------------------------------------
+static const std::array<param::description, 4> descriptions = {{
+	param::range_description (u"gain", 0., param::db_functions (), 1, u"dB"),
+	param::range_description (u"cutoff", 1000., param::exponent_functions<20, 20000> (), 0,
+							  u"Hz"),
+	param::range_description (u"pan", 0., param::linear_functions<-100, 100> (), 0),
+	param::list_description (u"bypass", 0, param::strings_on_off),
+}};
+
+//------------------------------------------------------------------------
+using parameter_list = std::vector<std::unique_ptr<Steinberg::Vst::Parameter>>;
+
+//------------------------------------------------------------------------
+/** a controller with num_parameters parameters, the convert functions of the descriptions are
+ *	either called directly or wrapped into the custom std::function as before
+ */
+parameter_list make_parameters (bool wrap_in_std_function)
+{
+	parameter_list result;
+	result.reserve (num_parameters);
+	for (size_t i = 0u; i < num_parameters; ++i)
+	{
+		auto p = std::make_unique<parameter> (static_cast<parameter::param_id> (i),
+											  descriptions[i % descriptions.size ()]);
+		if (wrap_in_std_function && p->description ().convert.to_plain)
+		{
+			p->set_custom_to_plain_func ([] (const auto& param, auto v) -> parameter::param_value {
+				return param.description ().convert.to_plain (v);
+			});
+			p->set_custom_to_normalized_func (
+				[] (const auto& param, auto v) -> parameter::param_value {
+					return param.description ().convert.to_normalized (v);
+				});
+		}
+		result.emplace_back (std::move (p));
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+template<typename Func>
+double measure_all (const parameter_list& parameters, Func func)
+{
+	auto ns = bench::measure (iterations, [&] () {
+		double sum = 0.;
+		for (size_t i = 0u; i < parameters.size (); ++i)
+			sum += func (*parameters[i], static_cast<double> (i & 0xffu) / 255.);
+		bench::do_not_optimize (sum);
+	});
+	return ns / static_cast<double> (parameters.size ());
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+double measure_construction (size_t num, Proc proc)
+{
+	auto ns = bench::measure (10u, [&] () {
+		parameter_list parameters;
+		parameters.reserve (num);
+		for (size_t i = 0u; i < num; ++i)
+		{
+			parameters.emplace_back (proc (static_cast<parameter::param_id> (i),
+										   descriptions[i % descriptions.size ()]));
+		}
+		bench::do_not_optimize (parameters);
+	});
+	return ns / static_cast<double> (num);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+VST3UTILS_BENCHMARK (parameter_convert)
+{
+	auto wrapped = make_parameters (true);
+	auto direct = make_parameters (false);
+
+	std::printf (" %zu parameters, time per call\n", num_parameters);
+	bench::report_header ("std::function", "direct");
+
+	auto to_plain = [] (const auto& p, double v) { return p.toPlain (v); };
+	bench::report ("toPlain", measure_all (wrapped, to_plain), measure_all (direct, to_plain));
+	auto to_normalized = [] (const auto& p, double v) { return p.toNormalized (v); };
+	bench::report ("toNormalized", measure_all (wrapped, to_normalized),
+				   measure_all (direct, to_normalized));
+}
+
+//------------------------------------------------------------------------
+VST3UTILS_BENCHMARK (parameter_construction)
+{
+	constexpr size_t num = 12000u;
+	std::printf (" %zu parameters, sizeof Vst::Parameter %zu bytes, vst3utils::parameter adds %zu "
+				 "bytes\n",
+				 num, sizeof (Steinberg::Vst::Parameter),
+				 sizeof (parameter) - sizeof (Steinberg::Vst::Parameter));
+	bench::report_header ("with listener", "plain");
+
+	auto with_listener = measure_construction (num, [] (auto pid, const auto& desc) {
+		auto p = std::make_unique<parameter> (pid, desc);
+		p->add_listener ([] (auto&, auto) {});
+		return p;
+	});
+	auto plain = measure_construction (
+		num, [] (auto pid, const auto& desc) { return std::make_unique<parameter> (pid, desc); });
+	bench::report ("construction per parameter", with_listener, plain);
+}
+
+//------------------------------------------------------------------------
+/** a preset load of 2000 parameters, followed by three automation updates of every parameter
+ *	within the same UI frame
+ */
+VST3UTILS_BENCHMARK (parameter_notification)
+{
+	constexpr size_t num = 2000u;
+	constexpr size_t updates_per_frame = 4u;
+	std::vector<std::unique_ptr<parameter>> parameters;
+	size_t callbacks = 0u;
+	for (size_t i = 0u; i < num; ++i)
+	{
+		parameters.emplace_back (std::make_unique<parameter> (
+			static_cast<parameter::param_id> (i), descriptions[i % descriptions.size ()]));
+		parameters.back ()->add_listener ([&] (auto&, auto) { ++callbacks; });
+	}
+	size_t frame = 0u;
+	auto load_preset = [&] () {
+		++frame;
+		for (size_t update = 0u; update < updates_per_frame; ++update)
+		{
+			for (size_t i = 0u; i < num; ++i)
+				parameters[i]->setNormalized (static_cast<double> ((i + update + frame) % 64u) /
+											  64.);
+		}
+	};
+
+	callbacks = 0u;
+	load_preset ();
+	auto direct_callbacks = callbacks;
+	auto direct = bench::measure (20u, load_preset);
+
+	notification_batcher batcher;
+	for (auto& p : parameters)
+		p->set_notification_batcher (&batcher);
+	auto load_preset_batched = [&] () {
+		load_preset ();
+		batcher.flush ();
+	};
+	callbacks = 0u;
+	load_preset_batched ();
+	auto batched_callbacks = callbacks;
+	auto batched = bench::measure (20u, load_preset_batched);
+
+	std::printf (" %zu parameters, %zu updates per parameter and frame\n", num, updates_per_frame);
+	std::printf ("  callbacks per frame: %zu direct, %zu batched\n", direct_callbacks,
+				 batched_callbacks);
+	bench::report_header ("direct", "batched");
+	bench::report ("frame", direct, batched);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
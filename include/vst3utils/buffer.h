@@ -11,6 +11,8 @@
 #include <cstdlib>
 #include <algorithm>
 #include <cassert>
+#include <type_traits>
+#include <utility>
 
 #ifdef _MSC_VER
 #include <malloc.h>
@@ -32,24 +34,98 @@ struct standard_allocator
 };
 
 //------------------------------------------------------------------------
-/** simple RAII buffer implementation */
+/** simple RAII buffer implementation
+ *
+ *	the allocator can either be a stateless policy with static allocate/deallocate functions or
+ *	an allocator object which is passed to the constructor (see memory_arena.h)
+ */
 template<typename T, typename allocatorT = standard_allocator>
-struct buffer final
+struct buffer final : private allocatorT
 {
-	buffer (size_t num_elements = 0) { allocate (num_elements); }
+	buffer (size_t num_elements = 0, const allocatorT& allocator = {}) : allocatorT (allocator)
+	{
+		allocate (num_elements);
+	}
 	~buffer () noexcept { deallocate (); }
 
-	/** allocate */
+	buffer (const buffer&) = delete;
+	buffer& operator= (const buffer&) = delete;
+
+	buffer (buffer&& other) noexcept : allocatorT (std::move (other.get_allocator_ref ()))
+	{
+		take (other);
+	}
+	buffer& operator= (buffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			deallocate ();
+			get_allocator_ref () = std::move (other.get_allocator_ref ());
+			take (other);
+		}
+		return *this;
+	}
+
+	/** exchange the memory of two buffers without any allocation */
+	void swap (buffer& other) noexcept
+	{
+		using std::swap;
+		swap (get_allocator_ref (), other.get_allocator_ref ());
+		swap (buffer_ptr, other.buffer_ptr);
+		swap (num_buffer_elements, other.num_buffer_elements);
+		swap (num_capacity_elements, other.num_capacity_elements);
+	}
+
+	/** allocate
+	 *
+	 *	the content of the buffer is undefined afterwards. if the capacity is large enough, the
+	 *	already allocated memory is reused.
+	 */
 	void allocate (size_t num_elements)
 	{
-		deallocate ();
-		if (num_elements == 0u)
+		if (num_elements <= num_capacity_elements)
+		{
+			num_buffer_elements = num_elements;
 			return;
+		}
+		deallocate ();
 		buffer_ptr = reinterpret_cast<T*> (allocatorT::allocate (num_elements * element_size ()));
 		if (buffer_ptr)
-			num_buffer_elements = num_elements;
+			num_buffer_elements = num_capacity_elements = num_elements;
+	}
+
+	/** make sure the capacity is at least num_elements, preserving the content */
+	void reserve (size_t num_elements)
+	{
+		if (num_elements <= num_capacity_elements)
+			return;
+		auto new_ptr =
+			reinterpret_cast<T*> (allocatorT::allocate (num_elements * element_size ()));
+		if (!new_ptr)
+			return;
+		if (buffer_ptr)
+			std::copy_n (buffer_ptr, num_buffer_elements, new_ptr);
+		auto num_elements_in_use = num_buffer_elements;
+		deallocate ();
+		buffer_ptr = new_ptr;
+		num_buffer_elements = num_elements_in_use;
+		num_capacity_elements = num_elements;
+	}
+
+	/** change the size, preserving the content. new elements are value initialized */
+	void resize (size_t num_elements)
+	{
+		reserve (num_elements);
+		if (num_elements > num_capacity_elements)
+			return;
+		if (num_elements > num_buffer_elements)
+			std::fill (buffer_ptr + num_buffer_elements, buffer_ptr + num_elements, T {});
+		num_buffer_elements = num_elements;
 	}
 
+	/** free the memory */
+	void release () noexcept { deallocate (); }
+
 	/** fill all elements in the buffer with the same value */
 	void fill (T value)
 	{
@@ -78,8 +154,12 @@ struct buffer final
 
 	/** returns the number of elements */
 	size_t size () const { return num_buffer_elements; }
+	/** returns the number of elements which fit into the allocated memory */
+	size_t capacity () const { return num_capacity_elements; }
 	/** returns the byte size of one element */
 	constexpr size_t element_size () const { return sizeof (T); }
+	/** returns the allocator */
+	const allocatorT& get_allocator () const { return *this; }
 
 	/** returns an iterator to the beginning */
 	T* begin () { return &buffer_ptr[0]; }
@@ -92,19 +172,38 @@ struct buffer final
 	const T* end () const { return &buffer_ptr[size ()]; }
 
 private:
-	void deallocate ()
+	void deallocate () noexcept
 	{
 		if (!buffer_ptr)
 			return;
-		allocatorT::deallocate (buffer_ptr, num_buffer_elements * element_size ());
+		allocatorT::deallocate (buffer_ptr, num_capacity_elements * element_size ());
 		buffer_ptr = nullptr;
-		num_buffer_elements = 0u;
+		num_buffer_elements = num_capacity_elements = 0u;
+	}
+
+	void take (buffer& other) noexcept
+	{
+		buffer_ptr = other.buffer_ptr;
+		num_buffer_elements = other.num_buffer_elements;
+		num_capacity_elements = other.num_capacity_elements;
+		other.buffer_ptr = nullptr;
+		other.num_buffer_elements = other.num_capacity_elements = 0u;
 	}
 
+	allocatorT& get_allocator_ref () noexcept { return *this; }
+
 	T* buffer_ptr {nullptr};
 	size_t num_buffer_elements {0u};
+	size_t num_capacity_elements {0u};
 };
 
+//------------------------------------------------------------------------
+template<typename T, typename allocatorT>
+inline void swap (buffer<T, allocatorT>& lhs, buffer<T, allocatorT>& rhs) noexcept
+{
+	lhs.swap (rhs);
+}
+
 //------------------------------------------------------------------------
 /** allocator that uses memory aligned allocations */
 template<size_t alignment>
@@ -146,5 +245,111 @@ struct alignment_allocator
 template<typename T, size_t alignment>
 using aligned_buffer = buffer<T, alignment_allocator<alignment>>;
 
+//------------------------------------------------------------------------
+/** the assumed size of a cpu cache line in bytes */
+static constexpr size_t cache_line_size = 64u;
+
+//------------------------------------------------------------------------
+/** planar multi channel audio buffer
+ *
+ *	all channels share one aligned allocation. the start of every channel is padded to a multiple
+ *	of the cache line size (or the alignment if it is larger), so each channel has the same
+ *	alignment guarantee as an aligned_buffer.
+ *
+ *	channels() returns an array of channel pointers which can directly be used as the
+ *	channelBuffers32 or channelBuffers64 member of Steinberg::Vst::AudioBusBuffers.
+ *
+ *	Example:
+ *
+ *		multichannel_buffer<float> scratch;
+ *		scratch.allocate (2, setup.maxSamplesPerBlock); // in setupProcessing
+ *
+ *		Steinberg::Vst::AudioBusBuffers bus {};
+ *		scratch.assign_to (bus); // in process
+ */
+template<typename T, size_t alignment = cache_line_size>
+struct multichannel_buffer final
+{
+	static_assert (alignment > 0 && (alignment & (alignment - 1)) == 0,
+				   "alignment must be a power of two");
+
+	multichannel_buffer (size_t num_channels = 0, size_t num_samples = 0)
+	{
+		allocate (num_channels, num_samples);
+	}
+
+	/** allocate num_channels channels with num_samples samples each */
+	void allocate (size_t num_channels, size_t num_samples)
+	{
+		constexpr auto pad_bytes = std::max (alignment, cache_line_size);
+		static_assert (pad_bytes % sizeof (T) == 0, "element size must divide the padding size");
+
+		auto channel_bytes = num_samples * sizeof (T);
+		if (auto d = channel_bytes % pad_bytes; d != 0u)
+			channel_bytes += pad_bytes - d;
+		channel_stride = channel_bytes / sizeof (T);
+		num_channel_samples = num_samples;
+
+		samples.allocate (num_channels * channel_stride);
+		channel_ptrs.allocate (samples.size () ? num_channels : 0u);
+		for (auto index = 0u; index < channel_ptrs.size (); ++index)
+			channel_ptrs[index] = samples.data () + index * channel_stride;
+		if (channel_ptrs.size () == 0u)
+			num_channel_samples = channel_stride = 0u;
+	}
+
+	/** fill all samples of all channels with the same value */
+	void fill (T value) { samples.fill (value); }
+	/** set all samples of all channels to zero */
+	void clear () { fill (static_cast<T> (0)); }
+
+	/** returns a pointer to the first sample of the channel */
+	T* operator[] (size_t channel)
+	{
+		assert (channel < num_channels ());
+		return channel_ptrs[channel];
+	}
+	/** returns a pointer to the first sample of the channel */
+	const T* operator[] (size_t channel) const
+	{
+		assert (channel < num_channels ());
+		return channel_ptrs[channel];
+	}
+
+	/** returns the array of channel pointers */
+	T** channels () { return channel_ptrs.data (); }
+	/** returns the array of channel pointers */
+	const T* const* channels () const { return channel_ptrs.data (); }
+
+	/** returns the number of channels */
+	size_t num_channels () const { return channel_ptrs.size (); }
+	/** returns the number of samples per channel */
+	size_t num_samples () const { return num_channel_samples; }
+	/** returns the distance in elements between the start of two adjacent channels */
+	size_t stride () const { return channel_stride; }
+
+	/** let the channel pointers of an AudioBusBuffers like struct point to this buffer
+	 *
+	 *	only the channel pointers and the number of channels are changed
+	 */
+	template<typename bus_buffers_t>
+	void assign_to (bus_buffers_t& bus)
+	{
+		static_assert (std::is_same_v<T, float> || std::is_same_v<T, double>,
+					   "only float and double buffers can be assigned to a bus");
+		bus.numChannels = static_cast<decltype (bus.numChannels)> (num_channels ());
+		if constexpr (std::is_same_v<T, float>)
+			bus.channelBuffers32 = channels ();
+		else
+			bus.channelBuffers64 = channels ();
+	}
+
+private:
+	aligned_buffer<T, alignment> samples;
+	buffer<T*> channel_ptrs;
+	size_t num_channel_samples {0u};
+	size_t channel_stride {0u};
+};
+
 //------------------------------------------------------------------------
 } // vst3utils
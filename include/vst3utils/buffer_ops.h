@@ -0,0 +1,333 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/buffer.h"
+#include "vst3utils/simd.h"
+#include <cassert>
+#include <initializer_list>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** vectorized sample kernels
+ *
+ *	all functions work on float and double samples and use the simd instruction set enabled at
+ *	compile time (SSE2 or AVX2 on x86, scalar elsewhere).
+ *
+ *	if all pointers passed to a function are aligned to the native vector alignment (which is the
+ *	case for aligned_buffer and multichannel_buffer) aligned loads and stores are used.
+ *
+ *	in and out may point to the same memory.
+ */
+
+namespace detail {
+
+//------------------------------------------------------------------------
+template<typename T, bool aligned>
+struct vector_access
+{
+	using vec = simd::vec<T>;
+
+	static vec load (const T* p) noexcept
+	{
+		if constexpr (aligned)
+			return vec::load (p);
+		else
+			return vec::loadu (p);
+	}
+	static void store (T* p, vec v) noexcept
+	{
+		if constexpr (aligned)
+			v.store (p);
+		else
+			v.storeu (p);
+	}
+};
+
+//------------------------------------------------------------------------
+/** calls body (access, index) for every full vector and returns the number of samples processed */
+template<typename T, typename Body>
+inline size_t vector_loop (size_t num_samples, std::initializer_list<const T*> ptrs,
+						   Body&& body) noexcept
+{
+	constexpr auto step = simd::vec<T>::size;
+	auto num_vector_samples = num_samples - (num_samples % step);
+	auto aligned = std::all_of (ptrs.begin (), ptrs.end (),
+								[] (auto p) { return simd::is_aligned (p); });
+	if (aligned)
+	{
+		for (size_t i = 0u; i < num_vector_samples; i += step)
+			body (vector_access<T, true> {}, i);
+	}
+	else
+	{
+		for (size_t i = 0u; i < num_vector_samples; i += step)
+			body (vector_access<T, false> {}, i);
+	}
+	return num_vector_samples;
+}
+
+//------------------------------------------------------------------------
+} // detail
+
+//------------------------------------------------------------------------
+/** set all samples to zero */
+template<typename T>
+inline void clear (T* out, size_t num_samples) noexcept
+{
+	auto zero = simd::vec<T>::zero ();
+	auto i = detail::vector_loop<T> (num_samples, {out},
+									 [&] (auto io, size_t index) { io.store (out + index, zero); });
+	for (; i < num_samples; ++i)
+		out[i] = static_cast<T> (0);
+}
+
+//------------------------------------------------------------------------
+/** set all samples to value */
+template<typename T>
+inline void fill (T* out, size_t num_samples, T value) noexcept
+{
+	auto v = simd::vec<T>::set1 (value);
+	auto i = detail::vector_loop<T> (num_samples, {out},
+									 [&] (auto io, size_t index) { io.store (out + index, v); });
+	for (; i < num_samples; ++i)
+		out[i] = value;
+}
+
+//------------------------------------------------------------------------
+/** out[i] = start + i * increment */
+template<typename T>
+inline void fill_ramp (T* out, size_t num_samples, T start, T increment) noexcept
+{
+	using vec = simd::vec<T>;
+	auto index = vec::ramp (static_cast<T> (0), static_cast<T> (1));
+	const auto index_step = vec::set1 (static_cast<T> (vec::size));
+	const auto s = vec::set1 (start);
+	const auto inc = vec::set1 (increment);
+	auto i = detail::vector_loop<T> (num_samples, {out}, [&] (auto io, size_t offset) {
+		io.store (out + offset, s + index * inc);
+		index = index + index_step;
+	});
+	for (; i < num_samples; ++i)
+		out[i] = start + static_cast<T> (i) * increment;
+}
+
+//------------------------------------------------------------------------
+/** copy samples from in to out */
+template<typename T>
+inline void copy (const T* in, T* out, size_t num_samples) noexcept
+{
+	auto i = detail::vector_loop<T> (num_samples, {in, out}, [&] (auto io, size_t index) {
+		io.store (out + index, io.load (in + index));
+	});
+	for (; i < num_samples; ++i)
+		out[i] = in[i];
+}
+
+//------------------------------------------------------------------------
+/** out[i] = func (in[i])
+ *
+ *	func is called with simd::vec<T> for all full vectors and with T for the remaining samples, so
+ *	it is usually a generic lambda written with the primitives of simd.h and fast_math.h.
+ */
+template<typename T, typename Func>
+inline void transform_samples (const T* in, T* out, size_t num_samples, Func&& func) noexcept
+{
+	auto i = detail::vector_loop<T> (num_samples, {in, out}, [&] (auto io, size_t index) {
+		io.store (out + index, func (io.load (in + index)));
+	});
+	for (; i < num_samples; ++i)
+		out[i] = func (in[i]);
+}
+
+//------------------------------------------------------------------------
+/** out = in * gain */
+template<typename T>
+inline void apply_gain (const T* in, T* out, size_t num_samples, T gain) noexcept
+{
+	auto g = simd::vec<T>::set1 (gain);
+	auto i = detail::vector_loop<T> (num_samples, {in, out}, [&] (auto io, size_t index) {
+		io.store (out + index, io.load (in + index) * g);
+	});
+	for (; i < num_samples; ++i)
+		out[i] = in[i] * gain;
+}
+
+//------------------------------------------------------------------------
+/** io *= gain */
+template<typename T>
+inline void apply_gain (T* io, size_t num_samples, T gain) noexcept
+{
+	apply_gain (io, io, num_samples, gain);
+}
+
+//------------------------------------------------------------------------
+/** out = in * gain where gain linearly moves from start_gain to end_gain
+ *
+ *	the gain of sample i is start_gain + i * (end_gain - start_gain) / num_samples, so end_gain is
+ *	the gain of the first sample of the next block
+ */
+template<typename T>
+inline void apply_gain_ramp (const T* in, T* out, size_t num_samples, T start_gain,
+							 T end_gain) noexcept
+{
+	using vec = simd::vec<T>;
+	if (num_samples == 0u)
+		return;
+	auto delta = (end_gain - start_gain) / static_cast<T> (num_samples);
+	auto g = vec::ramp (start_gain, delta);
+	auto g_step = vec::set1 (delta * static_cast<T> (vec::size));
+	auto i = detail::vector_loop<T> (num_samples, {in, out}, [&] (auto io, size_t index) {
+		io.store (out + index, io.load (in + index) * g);
+		g = g + g_step;
+	});
+	for (; i < num_samples; ++i)
+		out[i] = in[i] * (start_gain + static_cast<T> (i) * delta);
+}
+
+//------------------------------------------------------------------------
+/** io *= gain where gain linearly moves from start_gain to end_gain */
+template<typename T>
+inline void apply_gain_ramp (T* io, size_t num_samples, T start_gain, T end_gain) noexcept
+{
+	apply_gain_ramp (io, io, num_samples, start_gain, end_gain);
+}
+
+//------------------------------------------------------------------------
+/** out += in */
+template<typename T>
+inline void mix (const T* in, T* out, size_t num_samples) noexcept
+{
+	auto i = detail::vector_loop<T> (num_samples, {in, out}, [&] (auto io, size_t index) {
+		io.store (out + index, io.load (out + index) + io.load (in + index));
+	});
+	for (; i < num_samples; ++i)
+		out[i] += in[i];
+}
+
+//------------------------------------------------------------------------
+/** out += in * gain */
+template<typename T>
+inline void mix (const T* in, T* out, size_t num_samples, T gain) noexcept
+{
+	auto g = simd::vec<T>::set1 (gain);
+	auto i = detail::vector_loop<T> (num_samples, {in, out}, [&] (auto io, size_t index) {
+		io.store (out + index, io.load (out + index) + io.load (in + index) * g);
+	});
+	for (; i < num_samples; ++i)
+		out[i] += in[i] * gain;
+}
+
+//------------------------------------------------------------------------
+/** interleave planar channels into one buffer of num_channels * num_samples samples */
+template<typename T>
+inline void interleave (const T* const* in, T* out, size_t num_channels,
+						size_t num_samples) noexcept
+{
+	using vec = simd::vec<T>;
+	size_t i = 0u;
+	if (num_channels == 2u)
+	{
+		auto left = in[0];
+		auto right = in[1];
+		i = detail::vector_loop<T> (num_samples, {left, right, out}, [&] (auto io, size_t index) {
+			vec lo, hi;
+			vec::zip (io.load (left + index), io.load (right + index), lo, hi);
+			io.store (out + 2u * index, lo);
+			io.store (out + 2u * index + vec::size, hi);
+		});
+	}
+	for (; i < num_samples; ++i)
+	{
+		for (size_t c = 0u; c < num_channels; ++c)
+			out[i * num_channels + c] = in[c][i];
+	}
+}
+
+//------------------------------------------------------------------------
+/** deinterleave one buffer of num_channels * num_samples samples into planar channels */
+template<typename T>
+inline void deinterleave (const T* in, T* const* out, size_t num_channels,
+						  size_t num_samples) noexcept
+{
+	using vec = simd::vec<T>;
+	size_t i = 0u;
+	if (num_channels == 2u)
+	{
+		auto left = out[0];
+		auto right = out[1];
+		i = detail::vector_loop<T> (num_samples, {left, right, in}, [&] (auto io, size_t index) {
+			vec l, r;
+			vec::unzip (io.load (in + 2u * index), io.load (in + 2u * index + vec::size), l, r);
+			io.store (left + index, l);
+			io.store (right + index, r);
+		});
+	}
+	for (; i < num_samples; ++i)
+	{
+		for (size_t c = 0u; c < num_channels; ++c)
+			out[c][i] = in[i * num_channels + c];
+	}
+}
+
+//------------------------------------------------------------------------
+/** set all samples of the buffer to zero */
+template<typename T, typename allocatorT>
+inline void clear (buffer<T, allocatorT>& b) noexcept
+{
+	clear (b.data (), b.size ());
+}
+
+//------------------------------------------------------------------------
+/** copy the samples of in to out, both buffers must have the same size */
+template<typename T, typename allocator1, typename allocator2>
+inline void copy (const buffer<T, allocator1>& in, buffer<T, allocator2>& out) noexcept
+{
+	assert (in.size () == out.size ());
+	copy (in.data (), out.data (), std::min (in.size (), out.size ()));
+}
+
+//------------------------------------------------------------------------
+/** multiply all samples of the buffer with gain */
+template<typename T, typename allocatorT>
+inline void apply_gain (buffer<T, allocatorT>& b, T gain) noexcept
+{
+	apply_gain (b.data (), b.size (), gain);
+}
+
+//------------------------------------------------------------------------
+/** multiply all samples of the buffer with a linear gain ramp */
+template<typename T, typename allocatorT>
+inline void apply_gain_ramp (buffer<T, allocatorT>& b, T start_gain, T end_gain) noexcept
+{
+	apply_gain_ramp (b.data (), b.size (), start_gain, end_gain);
+}
+
+//------------------------------------------------------------------------
+/** add the samples of in to out, both buffers must have the same size */
+template<typename T, typename allocator1, typename allocator2>
+inline void mix (const buffer<T, allocator1>& in, buffer<T, allocator2>& out) noexcept
+{
+	assert (in.size () == out.size ());
+	mix (in.data (), out.data (), std::min (in.size (), out.size ()));
+}
+
+//------------------------------------------------------------------------
+/** add the samples of in multiplied by gain to out, both buffers must have the same size */
+template<typename T, typename allocator1, typename allocator2>
+inline void mix (const buffer<T, allocator1>& in, buffer<T, allocator2>& out, T gain) noexcept
+{
+	assert (in.size () == out.size ());
+	mix (in.data (), out.data (), std::min (in.size (), out.size ()), gain);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -10,6 +10,7 @@
 
 #include "pluginterfaces/base/fplatform.h"
 #include "pluginterfaces/base/ibstream.h"
+#include <stdexcept>
 
 //------------------------------------------------------------------------
 namespace vst3utils {
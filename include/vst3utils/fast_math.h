@@ -0,0 +1,211 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/simd.h"
+#include <array>
+#include <limits>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace simd {
+
+//------------------------------------------------------------------------
+/** polynomial approximations of exp and log
+ *
+ *	all functions work with float, double, simd::vec<float> and simd::vec<double>, so the same
+ *	code can be used in scalar code and in simd kernels. They are meant for the audio thread where
+ *	libm and the constexpr gcem functions are too slow to be called per sample.
+ *
+ *	maximum error over the whole input range:
+ *
+ *	| function | float         | double         |
+ *	|----------|---------------|----------------|
+ *	| exp2     | 4e-7 relative | 6e-16 relative |
+ *	| log2     | 2e-7          | 5e-16          |
+ *
+ *	the error of log2 is absolute for results in the range [-1..1] and relative otherwise.
+ *
+ *	exp, log and pow are computed via exp2 and log2, the additional rounding of the argument
+ *	scales the relative error of exp and pow by the magnitude of the exponent.
+ *
+ *	the input of exp2 is clamped to the exponent range of normal numbers, so there is no overflow
+ *	to infinity. The input of log2 is clamped to the smallest positive normal number, so the log
+ *	of zero and of negative numbers is a large negative finite number. NaNs are not handled.
+ */
+
+namespace detail {
+
+constexpr double ln2 = 0.693147180559945309417232121458176568;
+constexpr double log2e = 1.44269504088896340735992468100189214;
+constexpr double sqrt2 = 1.41421356237309504880168872420969808;
+
+//------------------------------------------------------------------------
+/** taylor series of 2^x: ln(2)^k / k! */
+template<typename T, int degree>
+constexpr std::array<T, degree + 1> make_exp2_coefficients () noexcept
+{
+	std::array<T, degree + 1> result {};
+	double c = 1.;
+	for (int k = 0; k <= degree; ++k)
+	{
+		result[k] = static_cast<T> (c);
+		c *= ln2 / (k + 1);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** series of log2 ((1 + s) / (1 - s)) / s: 2 / (ln(2) * (2k + 1)) */
+template<typename T, int terms>
+constexpr std::array<T, terms> make_log2_coefficients () noexcept
+{
+	std::array<T, terms> result {};
+	for (int k = 0; k < terms; ++k)
+		result[k] = static_cast<T> (2. / (ln2 * (2 * k + 1)));
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** one horner step per recursion, so the evaluation is unrolled at compile time */
+template<size_t k, typename V, typename T, size_t N>
+inline V horner (V acc, V x, const std::array<T, N>& c) noexcept
+{
+	if constexpr (k < 2u)
+		return acc;
+	else
+		return horner<k - 2u> (acc * x + splat<V> (c[k - 2u]), x, c);
+}
+
+//------------------------------------------------------------------------
+/** evaluates c[0] + c[1] * x + c[2] * x^2 + ...
+ *
+ *	the even and the odd coefficients are evaluated as two independent horner chains in x^2, which
+ *	halves the latency compared to a single horner chain.
+ */
+template<typename V, typename T, size_t N>
+inline V polynomial (V x, const std::array<T, N>& c) noexcept
+{
+	if constexpr (N == 1u)
+	{
+		return splat<V> (c[0]);
+	}
+	else
+	{
+		constexpr auto last_even = (N - 1u) & ~size_t (1);
+		constexpr auto last_odd = (N - 2u) | size_t (1);
+		auto x2 = x * x;
+		auto even = horner<last_even> (splat<V> (c[last_even]), x2, c);
+		auto odd = horner<last_odd> (splat<V> (c[last_odd]), x2, c);
+		return even + odd * x;
+	}
+}
+
+//------------------------------------------------------------------------
+/** 2^x with a taylor polynomial of the given degree on the fraction in the range [-0.5..0.5] */
+template<int degree, typename V>
+inline V exp2_poly (V x) noexcept
+{
+	using T = value_type_t<V>;
+	static constexpr auto c = make_exp2_coefficients<T, degree> ();
+	constexpr auto max_exponent = static_cast<T> (std::numeric_limits<T>::max_exponent - 1);
+	constexpr auto min_exponent = static_cast<T> (std::numeric_limits<T>::min_exponent - 1);
+
+	x = min (max (x, splat<V> (min_exponent)), splat<V> (max_exponent));
+	auto n = nearest (x);
+	return polynomial (x - n, c) * pow2 (n);
+}
+
+//------------------------------------------------------------------------
+/** log2 (x) = e + log2 (m) with m in the range [sqrt (0.5)..sqrt (2)), log2 (m) is computed with
+ *	the series of 2 * atanh (s) where s = (m - 1) / (m + 1) is in the range [-0.172..0.172]
+ */
+template<int terms, typename V>
+inline V log2_series (V x) noexcept
+{
+	using T = value_type_t<V>;
+	static constexpr auto c = make_log2_coefficients<T, terms> ();
+	const auto one = splat<V> (static_cast<T> (1));
+	const auto half = splat<V> (static_cast<T> (0.5));
+
+	x = max (x, splat<V> (std::numeric_limits<T>::min ()));
+	auto e = exponent (x);
+	auto m = mantissa (x);
+	// k is 1 if m >= sqrt (2), otherwise 0
+	auto k = nearest (m * splat<V> (static_cast<T> (1. / sqrt2)) - half);
+	m = m * (one - k * half);
+	e = e + k;
+	auto s = (m - one) / (m + one);
+	return e + s * polynomial (s * s, c);
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+struct full_precision;
+
+template<>
+struct full_precision<float>
+{
+	static constexpr int exp2_degree = 6;
+	static constexpr int log2_terms = 4;
+};
+
+template<>
+struct full_precision<double>
+{
+	static constexpr int exp2_degree = 12;
+	static constexpr int log2_terms = 10;
+};
+
+//------------------------------------------------------------------------
+} // detail
+
+//------------------------------------------------------------------------
+/** 2^x */
+template<typename V>
+inline V exp2 (V x) noexcept
+{
+	return detail::exp2_poly<detail::full_precision<value_type_t<V>>::exp2_degree> (x);
+}
+
+//------------------------------------------------------------------------
+/** binary logarithm of x */
+template<typename V>
+inline V log2 (V x) noexcept
+{
+	return detail::log2_series<detail::full_precision<value_type_t<V>>::log2_terms> (x);
+}
+
+//------------------------------------------------------------------------
+/** e^x */
+template<typename V>
+inline V exp (V x) noexcept
+{
+	return exp2 (x * splat<V> (static_cast<value_type_t<V>> (detail::log2e)));
+}
+
+//------------------------------------------------------------------------
+/** natural logarithm of x */
+template<typename V>
+inline V log (V x) noexcept
+{
+	return log2 (x) * splat<V> (static_cast<value_type_t<V>> (detail::ln2));
+}
+
+//------------------------------------------------------------------------
+/** x^y for positive x */
+template<typename V>
+inline V pow (V x, V y) noexcept
+{
+	return exp2 (y * log2 (x));
+}
+
+//------------------------------------------------------------------------
+} // simd
+} // vst3utils
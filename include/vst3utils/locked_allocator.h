@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/buffer.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_WIN32)
+// only the memory and system info functions are needed, keep the rest of windows.h and its min and
+// max macros out of the code including this header
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define VST3UTILS_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#define VST3UTILS_UNDEF_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef VST3UTILS_UNDEF_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef VST3UTILS_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#ifdef VST3UTILS_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef VST3UTILS_UNDEF_NOMINMAX
+#endif
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define VST3UTILS_LOCKED_ALLOCATOR_POSIX 1
+#endif
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** memory statistics of locked_allocator allocations
+ *
+ *	can be shared by all allocators of one plug-in instance to monitor its realtime memory
+ *	footprint
+ */
+struct locked_memory_stats
+{
+	/** number of bytes currently allocated (including page rounding) */
+	std::atomic<size_t> allocated_bytes {0u};
+	/** number of bytes currently locked into physical memory */
+	std::atomic<size_t> locked_bytes {0u};
+};
+
+//------------------------------------------------------------------------
+/** allocator for buffer which prevents page faults on the realtime thread
+ *
+ *	the memory is allocated directly from the operating system, all pages are touched when
+ *	allocated (prefault) and optionally locked into physical memory (lock). For large buffers
+ *	like delay lines transparent huge pages can be requested (huge_pages, only on Linux).
+ *
+ *	locking may fail if the process exceeds its lock limit (RLIMIT_MEMLOCK), in this case the
+ *	memory is still usable but not locked, check locked_bytes to see how much memory is locked.
+ *
+ *	the returned memory is aligned to the cache line size
+ *
+ *	Example:
+ *
+ *		locked_memory_stats stats;
+ *		locked_buffer<float> delay_line (
+ *			0, {locked_allocator::prefault | locked_allocator::lock, &stats});
+ *		delay_line.allocate (max_delay_samples); // in setupProcessing
+ */
+struct locked_allocator
+{
+	enum flags : uint32_t
+	{
+		prefault = 1 << 0,
+		lock = 1 << 1,
+		huge_pages = 1 << 2,
+	};
+
+	uint32_t options {prefault};
+	locked_memory_stats* stats {nullptr};
+
+	void* allocate (size_t num_bytes)
+	{
+		auto page = page_size ();
+		auto map_size = num_bytes + header_size;
+		if (auto d = map_size % page; d != 0u)
+			map_size += page - d;
+
+		auto base = map (map_size);
+		if (!base)
+			return nullptr;
+		if (options & huge_pages)
+			advise_huge_pages (base, map_size);
+		bool is_locked = (options & lock) ? lock_pages (base, map_size) : false;
+		if (options & prefault)
+		{
+			auto bytes = static_cast<volatile uint8_t*> (base);
+			for (size_t offset = 0u; offset < map_size; offset += page)
+				bytes[offset] = 0;
+		}
+
+		header h {map_size, is_locked};
+		std::memcpy (base, &h, sizeof (h));
+		update_stats (h, true);
+		return static_cast<uint8_t*> (base) + header_size;
+	}
+
+	void deallocate (void* ptr, size_t)
+	{
+		if (!ptr)
+			return;
+		auto base = static_cast<uint8_t*> (ptr) - header_size;
+		header h;
+		std::memcpy (&h, base, sizeof (h));
+		update_stats (h, false);
+		if (h.locked)
+			unlock_pages (base, h.map_size);
+		unmap (base, h.map_size);
+	}
+
+	/** returns the number of bytes locked by all locked_allocators of this process */
+	static size_t total_locked_bytes () noexcept { return total_locked ().load (); }
+
+private:
+	struct header
+	{
+		size_t map_size;
+		bool locked;
+	};
+	static constexpr size_t header_size = cache_line_size;
+	static_assert (sizeof (header) <= header_size);
+
+	static std::atomic<size_t>& total_locked () noexcept
+	{
+		static std::atomic<size_t> value {0u};
+		return value;
+	}
+
+	void update_stats (const header& h, bool add) noexcept
+	{
+		auto locked_size = h.locked ? h.map_size : 0u;
+		if (add)
+		{
+			total_locked () += locked_size;
+			if (stats)
+			{
+				stats->allocated_bytes += h.map_size;
+				stats->locked_bytes += locked_size;
+			}
+		}
+		else
+		{
+			total_locked () -= locked_size;
+			if (stats)
+			{
+				stats->allocated_bytes -= h.map_size;
+				stats->locked_bytes -= locked_size;
+			}
+		}
+	}
+
+#if defined(_WIN32)
+	static size_t page_size () noexcept
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo (&info);
+		return static_cast<size_t> (info.dwPageSize);
+	}
+	static void* map (size_t size) noexcept
+	{
+		return VirtualAlloc (nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+	static void unmap (void* ptr, size_t) noexcept { VirtualFree (ptr, 0, MEM_RELEASE); }
+	static bool lock_pages (void* ptr, size_t size) noexcept { return VirtualLock (ptr, size); }
+	static void unlock_pages (void* ptr, size_t size) noexcept { VirtualUnlock (ptr, size); }
+	static void advise_huge_pages (void*, size_t) noexcept {}
+#elif defined(VST3UTILS_LOCKED_ALLOCATOR_POSIX)
+	static size_t page_size () noexcept
+	{
+		static const size_t size = static_cast<size_t> (sysconf (_SC_PAGESIZE));
+		return size;
+	}
+	static void* map (size_t size) noexcept
+	{
+		auto ptr = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return ptr == MAP_FAILED ? nullptr : ptr;
+	}
+	static void unmap (void* ptr, size_t size) noexcept { munmap (ptr, size); }
+	static bool lock_pages (void* ptr, size_t size) noexcept { return mlock (ptr, size) == 0; }
+	static void unlock_pages (void* ptr, size_t size) noexcept { munlock (ptr, size); }
+	static void advise_huge_pages (void* ptr, size_t size) noexcept
+	{
+#if defined(MADV_HUGEPAGE)
+		madvise (ptr, size, MADV_HUGEPAGE);
+#endif
+	}
+#else
+	static size_t page_size () noexcept { return 4096u; }
+	static void* map (size_t size) noexcept
+	{
+		return alignment_allocator<cache_line_size>::allocate (size);
+	}
+	static void unmap (void* ptr, size_t size) noexcept
+	{
+		alignment_allocator<cache_line_size>::deallocate (ptr, size);
+	}
+	static bool lock_pages (void*, size_t) noexcept { return false; }
+	static void unlock_pages (void*, size_t) noexcept {}
+	static void advise_huge_pages (void*, size_t) noexcept {}
+#endif
+};
+
+//------------------------------------------------------------------------
+template<typename T>
+using locked_buffer = buffer<T, locked_allocator>;
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/buffer.h"
+#include <cassert>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** monotonic memory arena
+ *
+ *	reserves one memory block up front (not realtime safe) and hands out aligned sub allocations
+ *	from it in constant time without calling the system allocator (realtime safe).
+ *
+ *	memory is given back either all at once via reset () or up to a marker via release (). A frame
+ *	object does this automatically when it goes out of scope. Deallocating the most recent
+ *	allocation gives its memory back immediately, other deallocations are ignored.
+ *
+ *	not thread safe
+ *
+ *	Example:
+ *
+ *		memory_arena<> arena;
+ *		arena.reserve (1024 * 1024); // in setupProcessing
+ *
+ *		// in process
+ *		memory_arena<>::frame scratch_frame (arena);
+ *		arena_buffer<float> scratch (data.numSamples, {&arena});
+ *
+ *	note: all buffers allocated inside a frame must be destroyed before the frame is destroyed
+ */
+template<size_t alignment = cache_line_size>
+class memory_arena
+{
+public:
+	static_assert (alignment > 0 && (alignment & (alignment - 1)) == 0,
+				   "alignment must be a power of two");
+
+	using marker = size_t;
+
+	memory_arena (size_t num_bytes = 0) { reserve (num_bytes); }
+	memory_arena (const memory_arena&) = delete;
+	memory_arena& operator= (const memory_arena&) = delete;
+
+	/** reserve the memory block
+	 *
+	 *	this allocates memory and invalidates all previous allocations, so it should only be called
+	 *	outside of the realtime thread
+	 */
+	void reserve (size_t num_bytes)
+	{
+		block.allocate (round_up (num_bytes));
+		offset = 0u;
+	}
+
+	/** allocate aligned memory from the arena
+	 *
+	 *	@return nullptr if the arena has not enough space left
+	 */
+	void* allocate (size_t num_bytes) noexcept
+	{
+		auto size = round_up (num_bytes);
+		if (size > available ())
+			return nullptr;
+		auto ptr = block.data () + offset;
+		offset += size;
+		return ptr;
+	}
+
+	/** deallocate memory
+	 *
+	 *	only the most recent allocation is given back to the arena, otherwise this is a no-op
+	 */
+	void deallocate (void* ptr, size_t num_bytes) noexcept
+	{
+		auto size = round_up (num_bytes);
+		if (ptr && size <= offset && static_cast<uint8_t*> (ptr) + size == block.data () + offset)
+			offset -= size;
+	}
+
+	/** give back all allocations */
+	void reset () noexcept { offset = 0u; }
+
+	/** returns a marker for the current allocation state */
+	marker mark () const noexcept { return offset; }
+	/** give back all allocations made after the marker was taken */
+	void release (marker m) noexcept
+	{
+		assert (m <= offset);
+		offset = m;
+	}
+
+	/** returns the number of reserved bytes */
+	size_t capacity () const noexcept { return block.size (); }
+	/** returns the number of bytes in use */
+	size_t used () const noexcept { return offset; }
+	/** returns the number of bytes left */
+	size_t available () const noexcept { return block.size () - offset; }
+
+	/** scoped frame which releases all allocations made during its lifetime */
+	struct frame
+	{
+		frame (memory_arena& arena) noexcept : arena (arena), m (arena.mark ()) {}
+		~frame () noexcept { arena.release (m); }
+
+		frame (const frame&) = delete;
+		frame& operator= (const frame&) = delete;
+
+	private:
+		memory_arena& arena;
+		marker m;
+	};
+
+private:
+	static constexpr size_t round_up (size_t num_bytes) noexcept
+	{
+		return (num_bytes + alignment - 1u) & ~(alignment - 1u);
+	}
+
+	aligned_buffer<uint8_t, alignment> block;
+	size_t offset {0u};
+};
+
+//------------------------------------------------------------------------
+/** allocator for buffer using a memory_arena */
+template<size_t alignment = cache_line_size>
+struct arena_allocator
+{
+	memory_arena<alignment>* arena {nullptr};
+
+	void* allocate (size_t num_bytes) noexcept
+	{
+		assert (arena && "arena_allocator without arena");
+		return arena ? arena->allocate (num_bytes) : nullptr;
+	}
+	void deallocate (void* ptr, size_t num_bytes) noexcept
+	{
+		if (arena)
+			arena->deallocate (ptr, num_bytes);
+	}
+};
+
+//------------------------------------------------------------------------
+template<typename T, size_t alignment = cache_line_size>
+using arena_buffer = buffer<T, arena_allocator<alignment>>;
+
+//------------------------------------------------------------------------
+} // vst3utils
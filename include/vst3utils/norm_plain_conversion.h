@@ -9,12 +9,61 @@
 #pragma once
 
 #include "../../gcem/include/gcem.hpp"
+#include "vst3utils/buffer_ops.h"
+#include "vst3utils/fast_math.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define VST3UTILS_HAS_BUILTIN_IS_CONSTANT_EVALUATED 1
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define VST3UTILS_HAS_BUILTIN_IS_CONSTANT_EVALUATED 1
+#endif
 
 //------------------------------------------------------------------------
 namespace vst3utils {
+namespace detail {
+
+//------------------------------------------------------------------------
+/** returns true when called during constant evaluation, compilers without support for it always
+ *	take the constexpr path
+ */
+inline constexpr bool is_constant_evaluated () noexcept
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+	return std::is_constant_evaluated ();
+#elif defined(VST3UTILS_HAS_BUILTIN_IS_CONSTANT_EVALUATED)
+	return __builtin_is_constant_evaluated ();
+#else
+	return true;
+#endif
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+inline constexpr T exp (T x) noexcept
+{
+	if (is_constant_evaluated ())
+		return static_cast<T> (gcem::exp (x));
+	return std::exp (x);
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+inline constexpr T log (T x) noexcept
+{
+	if (is_constant_evaluated ())
+		return static_cast<T> (gcem::log (x));
+	return std::log (x);
+}
+
+//------------------------------------------------------------------------
+} // detail
 
 //------------------------------------------------------------------------
 template<typename T>
@@ -75,7 +124,7 @@ inline constexpr T exp_to_normalized (T min, T max, T plain_value) noexcept
 	if (min_is_zero)
 		min += std::numeric_limits<T>::epsilon ();
 	auto result = gcem::log (plain_value / min) / gcem::log (max / min);
-	result = std::clamp (result, 0., 1.);
+	result = std::clamp (result, static_cast<T> (0), static_cast<T> (1));
 	return result;
 }
 
@@ -94,5 +143,306 @@ inline constexpr T db_to_gain (T db_value) noexcept
 	return static_cast<T> (gcem::pow (10, db_value * inv20));
 }
 
+//------------------------------------------------------------------------
+/** exponential mapping between normalized and plain values
+
+the same curve as normalized_to_exp and exp_to_normalized, but the logarithm of the range and all
+reciprocals are computed once in the constructor. During constant evaluation the gcem functions are
+used, at runtime std::exp and std::log, and the batch versions use simd and the approximations of
+fast_math.h.
+
+if min is zero, the curve starts at epsilon and is shifted down by epsilon like normalized_to_exp.
+to_normalized is the exact inverse of this shifted curve.
+
+Example:
+
+	static constexpr exp_mapping<double> frequency_mapping {20., 20000.};
+
+	auto hz = frequency_mapping.to_plain (0.5);
+	frequency_mapping.to_plain (modulation, cutoff, num_samples);
+
+ */
+template<typename T>
+class exp_mapping
+{
+public:
+	constexpr exp_mapping (T min, T max) noexcept
+	: min_value (min)
+	, max_value (max)
+	, offset (min == static_cast<T> (0) ? std::numeric_limits<T>::epsilon () : static_cast<T> (0))
+	, start (min + offset)
+	, inv_start (static_cast<T> (1) / start)
+	, log_range (detail::log (max / start))
+	, inv_log_range (static_cast<T> (1) / log_range)
+	{
+	}
+
+	constexpr T min () const noexcept { return min_value; }
+	constexpr T max () const noexcept { return max_value; }
+
+	/** convert a normalized value [0..1] to the plain value [min..max] */
+	constexpr T to_plain (T normalized_value) const noexcept
+	{
+		auto result = start * detail::exp (normalized_value * log_range) - offset;
+		return std::clamp (result, min_value, max_value);
+	}
+
+	/** convert a plain value [min..max] to the normalized value [0..1] */
+	constexpr T to_normalized (T plain_value) const noexcept
+	{
+		auto result = detail::log ((plain_value + offset) * inv_start) * inv_log_range;
+		return std::clamp (result, static_cast<T> (0), static_cast<T> (1));
+	}
+
+	/** convert num_samples normalized values with simd */
+	void to_plain (const T* in, T* out, size_t num_samples) const noexcept
+	{
+		const auto log2_range = log_range * static_cast<T> (simd::detail::log2e);
+		transform_samples (in, out, num_samples, [this, log2_range] (auto x) {
+			using V = decltype (x);
+			auto result = simd::splat<V> (start) * simd::exp2 (x * simd::splat<V> (log2_range)) -
+						  simd::splat<V> (offset);
+			return simd::clamp (result, simd::splat<V> (min_value), simd::splat<V> (max_value));
+		});
+	}
+
+	/** convert num_samples plain values with simd */
+	void to_normalized (const T* in, T* out, size_t num_samples) const noexcept
+	{
+		const auto inv_log2_range = inv_log_range * static_cast<T> (simd::detail::ln2);
+		transform_samples (in, out, num_samples, [this, inv_log2_range] (auto x) {
+			using V = decltype (x);
+			auto result = simd::log2 ((x + simd::splat<V> (offset)) * simd::splat<V> (inv_start)) *
+						  simd::splat<V> (inv_log2_range);
+			return simd::clamp (result, simd::splat<V> (static_cast<T> (0)),
+								simd::splat<V> (static_cast<T> (1)));
+		});
+	}
+
+private:
+	T min_value;
+	T max_value;
+	T offset;
+	T start;
+	T inv_start;
+	T log_range;
+	T inv_log_range;
+};
+
+//------------------------------------------------------------------------
+/** mapping between normalized values and integer steps
+
+the same conversion as normalized_to_steps and steps_to_normalized with the scale factors and the
+reciprocal of the number of steps computed once. The batch versions quantize a whole buffer with
+simd, e.g. to drive a list parameter by audio rate modulation. The batch input is clamped to
+[0..1].
+
+ */
+class step_mapping
+{
+public:
+	constexpr step_mapping (int32_t num_steps = 1, int32_t start_value = 0) noexcept
+	: num_steps (num_steps)
+	, start_value (start_value)
+	, scale (static_cast<double> (num_steps + 1))
+	, inv_num_steps (1. / static_cast<double> (num_steps))
+	{
+	}
+
+	constexpr int32_t steps () const noexcept { return num_steps; }
+	constexpr int32_t start () const noexcept { return start_value; }
+
+	/** convert a normalized value [0..1] to the step [start..start + num_steps] */
+	template<typename T>
+	constexpr int32_t to_steps (T normalized_value) const noexcept
+	{
+		auto step = static_cast<int32_t> (normalized_value * static_cast<T> (scale));
+		return std::min (num_steps, step) + start_value;
+	}
+
+	/** convert a step [start..start + num_steps] to the normalized value [0..1] */
+	template<typename T = double>
+	constexpr T to_normalized (int32_t step) const noexcept
+	{
+		return static_cast<T> (step - start_value) * static_cast<T> (inv_num_steps);
+	}
+
+	/** convert num_samples normalized values to steps with simd */
+	template<typename T>
+	void to_steps (const T* in, int32_t* out, size_t num_samples) const noexcept
+	{
+		using vec = simd::vec<T>;
+		const auto zero = vec::zero ();
+		const auto one = vec::set1 (static_cast<T> (1));
+		const auto s = vec::set1 (static_cast<T> (scale));
+		const auto max_step = vec::set1 (static_cast<T> (num_steps));
+		const auto start = vec::set1 (static_cast<T> (start_value));
+		auto i = detail::vector_loop<T> (num_samples, {in}, [&] (auto io, size_t index) {
+			auto x = simd::clamp (io.load (in + index), zero, one);
+			auto step = truncate (min (x * s, max_step)) + start;
+			step.store_int32 (out + index);
+		});
+		for (; i < num_samples; ++i)
+			out[i] = to_steps (std::clamp (in[i], static_cast<T> (0), static_cast<T> (1)));
+	}
+
+	/** convert num_samples steps to normalized values */
+	template<typename T>
+	void to_normalized (const int32_t* in, T* out, size_t num_samples) const noexcept
+	{
+		for (size_t i = 0u; i < num_samples; ++i)
+			out[i] = to_normalized<T> (in[i]);
+	}
+
+	/** snap num_samples normalized values to the normalized value of their step with simd */
+	template<typename T>
+	void quantize (const T* in, T* out, size_t num_samples) const noexcept
+	{
+		const auto s = static_cast<T> (scale);
+		const auto max_step = static_cast<T> (num_steps);
+		const auto inv = static_cast<T> (inv_num_steps);
+		transform_samples (in, out, num_samples, [=] (auto x) {
+			using V = decltype (x);
+			using simd::min;
+			using simd::truncate;
+			x = simd::clamp (x, simd::splat<V> (static_cast<T> (0)),
+							 simd::splat<V> (static_cast<T> (1)));
+			return truncate (min (x * simd::splat<V> (s), simd::splat<V> (max_step))) *
+				   simd::splat<V> (inv);
+		});
+	}
+
+private:
+	int32_t num_steps;
+	int32_t start_value;
+	double scale;
+	double inv_num_steps;
+};
+
+//------------------------------------------------------------------------
+/** batch conversions
+ *
+ *	convert num_samples values from in to out (which may be the same memory) with simd and the
+ *	approximations of fast_math.h. The results differ from the scalar functions above by the
+ *	documented error of simd::exp2 and simd::log2. Use them to convert whole automation or
+ *	modulation buffers per block. db_to_gain and gain_to_db can trade precision for speed with
+ *	db_precision.
+ */
+
+//------------------------------------------------------------------------
+template<typename T>
+inline void normalized_to_plain (T min, T max, const T* in, T* out, size_t num_samples) noexcept
+{
+	const auto range = max - min;
+	transform_samples (in, out, num_samples, [=] (auto x) {
+		using V = decltype (x);
+		return x * simd::splat<V> (range) + simd::splat<V> (min);
+	});
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+inline void normalized_to_exp (T min, T max, const T* in, T* out, size_t num_samples) noexcept
+{
+	exp_mapping<T> (min, max).to_plain (in, out, num_samples);
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+inline void exp_to_normalized (T min, T max, const T* in, T* out, size_t num_samples) noexcept
+{
+	exp_mapping<T> (min, max).to_normalized (in, out, num_samples);
+}
+
+//------------------------------------------------------------------------
+/** precision of the approximated dB/gain conversions */
+enum class db_precision
+{
+	/** the precision of simd::exp2 and simd::log2 (a few ulp of the sample type) */
+	exact,
+	/** error below 0.01 dB */
+	hundredth_db,
+	/** error below 0.1 dB */
+	tenth_db,
+};
+
+namespace detail {
+
+//------------------------------------------------------------------------
+template<db_precision precision, typename T>
+struct db_approximation
+{
+	static constexpr int exp2_degree = simd::detail::full_precision<T>::exp2_degree;
+	static constexpr int log2_terms = simd::detail::full_precision<T>::log2_terms;
+};
+
+template<typename T>
+struct db_approximation<db_precision::hundredth_db, T>
+{
+	static constexpr int exp2_degree = 3;
+	static constexpr int log2_terms = 2;
+};
+
+template<typename T>
+struct db_approximation<db_precision::tenth_db, T>
+{
+	static constexpr int exp2_degree = 2;
+	static constexpr int log2_terms = 1;
+};
+
+// 20 * log10 (2) and log2 (10) / 20
+constexpr double db_per_octave = 6.02059991327962390427477789448986053;
+constexpr double octaves_per_db = 0.166096404744368117393515971474469508;
+
+//------------------------------------------------------------------------
+} // detail
+
+//------------------------------------------------------------------------
+/** approximated gain_to_db for float, double and simd::vec
+ *
+ *	the log2 is computed from the exponent bits and a short polynomial of the mantissa, the
+ *	polynomial degree is chosen by precision. Gains <= 0 are clamped to the smallest normal
+ *	number.
+ */
+template<db_precision precision, typename V>
+inline V fast_gain_to_db (V gain_value) noexcept
+{
+	using T = simd::value_type_t<V>;
+	using approximation = detail::db_approximation<precision, T>;
+	return simd::detail::log2_series<approximation::log2_terms> (gain_value) *
+		   simd::splat<V> (static_cast<T> (detail::db_per_octave));
+}
+
+//------------------------------------------------------------------------
+/** approximated db_to_gain for float, double and simd::vec
+ *
+ *	2^x is computed from a short polynomial of the fraction of x which is then scaled by writing
+ *	the integer part into the exponent bits, the polynomial degree is chosen by precision.
+ */
+template<db_precision precision, typename V>
+inline V fast_db_to_gain (V db_value) noexcept
+{
+	using T = simd::value_type_t<V>;
+	using approximation = detail::db_approximation<precision, T>;
+	return simd::detail::exp2_poly<approximation::exp2_degree> (
+		db_value * simd::splat<V> (static_cast<T> (detail::octaves_per_db)));
+}
+
+//------------------------------------------------------------------------
+template<db_precision precision = db_precision::exact, typename T>
+inline void gain_to_db (const T* in, T* out, size_t num_samples) noexcept
+{
+	transform_samples (in, out, num_samples,
+					   [] (auto x) { return fast_gain_to_db<precision> (x); });
+}
+
+//------------------------------------------------------------------------
+template<db_precision precision = db_precision::exact, typename T>
+inline void db_to_gain (const T* in, T* out, size_t num_samples) noexcept
+{
+	transform_samples (in, out, num_samples,
+					   [] (auto x) { return fast_db_to_gain<precision> (x); });
+}
+
 //------------------------------------------------------------------------
 } // vst3utils
@@ -10,6 +10,7 @@
 
 #include "vst3utils/parameter_description.h"
 #include "vst3utils/string_conversion.h"
+#include "vst3utils/string_list_index.h"
 #include "public.sdk/source/vst/vstparameters.h"
 #include <charconv>
 #include <functional>
@@ -17,6 +18,7 @@
 #include <vector>
 #include <algorithm>
 #include <iterator>
+#include <memory>
 
 #if !defined(__cpp_lib_to_chars) || !defined(__cpp_lib_to_chars)
 #include "pluginterfaces/base/ustring.h"
@@ -25,6 +27,51 @@
 //------------------------------------------------------------------------
 namespace vst3utils {
 
+class parameter;
+class preset_loader;
+
+//------------------------------------------------------------------------
+/** coalesces the listener notifications of parameters
+
+parameters using a batcher do not call their listeners on every change. The change is recorded
+and the listeners are called once per changed parameter with the current value when the batcher
+is flushed, usually from a UI timer or after loading a preset.
+
+the batcher must outlive the parameters using it or be removed from them before it is destroyed.
+
+Example:
+
+	notification_batcher batcher;
+	for (auto& param : my_parameters)
+		param->set_notification_batcher (&batcher);
+
+	// in the UI timer
+	batcher.flush ();
+
+ */
+class notification_batcher
+{
+public:
+	/** call the listeners of all parameters changed since the last flush
+	 *
+	 *	changes made by the listeners are notified on the next flush
+	 */
+	inline void flush ();
+
+	/** returns the number of parameters with pending notifications */
+	size_t size () const noexcept { return pending.size (); }
+	/** returns true if no notifications are pending */
+	bool empty () const noexcept { return pending.empty (); }
+
+private:
+	friend class parameter;
+
+	inline void remove (parameter* param) noexcept;
+
+	std::vector<parameter*> pending;
+	std::vector<parameter*> processing;
+};
+
 //------------------------------------------------------------------------
 /** a vst3 sdk compatible parameter class using a param::description structure to initialize
 
@@ -72,6 +119,7 @@ public:
 
 	inline parameter (param_id pid, const param::description& desc,
 					  int32_t flags = Flags::kCanAutomate);
+	inline ~parameter () noexcept override;
 
 	inline param_value getPlain () const { return toPlain (getNormalized ()); }
 	inline void setPlain (param_value plain) { setNormalized (toNormalized (plain)); }
@@ -92,7 +140,10 @@ public:
 	inline token add_listener (const value_changed_func& func);
 	inline void remove_listener (token token);
 
-	//-- custom conversion
+	/** notify the listeners via the batcher instead of on every change, nullptr to disable */
+	inline void set_notification_batcher (notification_batcher* batcher);
+
+	//-- custom conversion, takes precedence over the convert functions of the description
 	using to_plain_func = std::function<param_value (const parameter& param, param_value norm)>;
 	using to_normalized_func =
 		std::function<param_value (const parameter& param, param_value plain)>;
@@ -115,17 +166,36 @@ private:
 	}
 	const tchar* str_cast (const char16_t* s) const { return reinterpret_cast<const tchar*> (s); }
 
+	friend class notification_batcher;
+	friend class preset_loader;
+	inline void notify_listeners ();
+
+	/** listeners and custom functions, only allocated when one of them is used so that large
+	 *	parameter sets without customizations only pay for one pointer per parameter
+	 */
+	struct extension
+	{
+		std::vector<std::pair<value_changed_func, token>> listeners;
+		std::vector<std::pair<value_changed_func, token>> listeners_to_add;
+		std::vector<token> listeners_to_remove;
+		token tokenCounter {0};
+		int32_t iterating_listeners {0};
+		notification_batcher* batcher {nullptr};
+		bool notification_pending {false};
+
+		to_plain_func to_plain {};
+		to_normalized_func to_normalized {};
+		to_string_func to_string {};
+		from_string_func from_string {};
+	};
+
+	inline extension& get_extension ();
+
 	const param::description& desc;
-	std::vector<std::pair<value_changed_func, token>> listeners;
-	std::vector<std::pair<value_changed_func, token>> listeners_to_add;
-	std::vector<token> listeners_to_remove;
-	token tokenCounter {0};
-	int32_t iterating_listeners {0};
-
-	to_plain_func to_plain {};
-	to_normalized_func to_normalized {};
-	to_string_func to_string {};
-	from_string_func from_string {};
+	const param::range* range {nullptr};
+	const string_list_index* list_index {nullptr};
+	step_mapping steps {};
+	std::unique_ptr<extension> ext;
 };
 
 //------------------------------------------------------------------------
@@ -143,73 +213,85 @@ inline parameter::parameter (param_id pid, const param::description& desc, int32
 	if (auto stepCount = std::get_if<param::step_count> (&desc.range_or_step_count))
 	{
 		info.stepCount = stepCount->num_steps;
+		steps = step_mapping (stepCount->num_steps, stepCount->start_value);
 		setPrecision (0);
 		if (stepCount->unit)
 			tstrncpy (info.units, stepCount->unit, std::size (info.units));
 		if (stepCount->string_list)
+		{
 			info.flags |= Flags::kIsList;
+			list_index =
+				&string_list_index::get (stepCount->string_list, stepCount->num_steps + 1u);
+		}
 	}
-	else if (auto range = std::get_if<param::range> (&desc.range_or_step_count))
+	else if ((range = std::get_if<param::range> (&desc.range_or_step_count)))
 	{
 		setPrecision (range->precision);
 		if (range->unit)
 			tstrncpy (info.units, range->unit, std::size (info.units));
 	}
-	if (desc.convert.to_plain)
-	{
-		set_custom_to_plain_func (
-			[] (const auto& p, auto v) -> param_value { return p.desc.convert.to_plain (v); });
-	}
-	if (desc.convert.to_normalized)
-	{
-		set_custom_to_normalized_func (
-			[] (const auto& p, auto v) -> param_value { return p.desc.convert.to_normalized (v); });
-	}
 	setNormalized (info.defaultNormalizedValue);
 }
 
 //------------------------------------------------------------------------
-inline void parameter::set_custom_to_plain_func (const to_plain_func& func) { to_plain = func; }
+inline auto parameter::get_extension () -> extension&
+{
+	if (!ext)
+		ext = std::make_unique<extension> ();
+	return *ext;
+}
+
+//------------------------------------------------------------------------
+inline void parameter::set_custom_to_plain_func (const to_plain_func& func)
+{
+	get_extension ().to_plain = func;
+}
 
 //------------------------------------------------------------------------
 inline void parameter::set_custom_to_normalized_func (const to_normalized_func& func)
 {
-	to_normalized = func;
+	get_extension ().to_normalized = func;
 }
 
 //------------------------------------------------------------------------
-inline void parameter::set_custom_to_string_func (const to_string_func& func) { to_string = func; }
+inline void parameter::set_custom_to_string_func (const to_string_func& func)
+{
+	get_extension ().to_string = func;
+}
 
 //------------------------------------------------------------------------
 inline void parameter::set_custom_from_string_func (const from_string_func& func)
 {
-	from_string = func;
+	get_extension ().from_string = func;
 }
 
 //------------------------------------------------------------------------
 inline auto parameter::add_listener (const value_changed_func& func) -> token
 {
-	auto token = ++tokenCounter;
-	if (iterating_listeners)
-		listeners_to_add.emplace_back (func, token);
+	auto& e = get_extension ();
+	auto token = ++e.tokenCounter;
+	if (e.iterating_listeners)
+		e.listeners_to_add.emplace_back (func, token);
 	else
-		listeners.emplace_back (func, token);
+		e.listeners.emplace_back (func, token);
 	return token;
 }
 
 //------------------------------------------------------------------------
 inline void parameter::remove_listener (token t)
 {
-	if (iterating_listeners)
+	if (!ext)
+		return;
+	if (ext->iterating_listeners)
 	{
-		listeners_to_remove.emplace_back (t);
+		ext->listeners_to_remove.emplace_back (t);
 	}
 	else
 	{
-		auto it = std::find_if (listeners.begin (), listeners.end (),
+		auto it = std::find_if (ext->listeners.begin (), ext->listeners.end (),
 								[&] (const auto& p) { return p.second == t; });
-		if (it != listeners.end ())
-			listeners.erase (it);
+		if (it != ext->listeners.end ())
+			ext->listeners.erase (it);
 	}
 }
 
@@ -225,9 +307,9 @@ inline void parameter::toString (param_value value_normalized, string_128 string
 {
 	using namespace Steinberg;
 
-	if (to_string)
+	if (ext && ext->to_string)
 	{
-		to_string (*this, value_normalized, string);
+		ext->to_string (*this, value_normalized, string);
 		return;
 	}
 	auto plain = toPlain (value_normalized);
@@ -242,15 +324,16 @@ inline void parameter::toString (param_value value_normalized, string_128 string
 	else
 	{
 #if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
-		std::string ascii;
-		ascii.resize (128);
-		auto res = std::to_chars (ascii.data (), ascii.data () + ascii.size (), plain,
+		char ascii[128];
+		auto res = std::to_chars (std::begin (ascii), std::end (ascii), plain,
 								  std::chars_format::fixed, precision);
 		if (res.ec == std::errc ())
 		{
-			ascii.resize (res.ptr - ascii.data ());
-			copy_ascii_to_utf16 (ascii, string, string + sizeof (string_128) / sizeof (tchar));
+			copy_ascii_to_utf16 ({ascii, static_cast<size_t> (res.ptr - ascii)}, string,
+								 string + sizeof (string_128) / sizeof (tchar));
 		}
+		else
+			string[0] = 0;
 #else
 		UString wrapper (string, str16BufferSize (string_128));
 		if (!wrapper.printFloat (plain, precision))
@@ -264,26 +347,21 @@ inline bool parameter::fromString (const tchar* string, param_value& value_norma
 {
 	using namespace Steinberg;
 
-	if (from_string)
-		return from_string (*this, string, value_normalized);
-	auto stepCount = std::get_if<param::step_count> (&desc.range_or_step_count);
-	if (stepCount && stepCount->string_list)
+	if (ext && ext->from_string)
+		return ext->from_string (*this, string, value_normalized);
+	if (list_index)
 	{
-		for (auto index = 0u; index <= stepCount->num_steps; ++index)
-		{
-			if (tstrcmp (string, str_cast (stepCount->string_list[index])) == 0)
-			{
-				value_normalized = toNormalized (index);
-				return true;
-			}
-		}
-		return false;
+		auto index = list_index->find (reinterpret_cast<const char16_t*> (string));
+		if (index < 0)
+			return false;
+		value_normalized = toNormalized (index + steps.start ());
+		return true;
 	}
 #if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
 	double value = 0.;
-	auto ascii = copy_utf16_to_ascii (string);
-	auto res = std::from_chars (ascii.data (), ascii.data () + ascii.size (), value,
-								std::chars_format::fixed);
+	char ascii[128];
+	auto length = copy_utf16_to_ascii (string, std::begin (ascii), std::end (ascii));
+	auto res = std::from_chars (ascii, ascii + length, value, std::chars_format::fixed);
 	if (res.ec == std::errc ())
 	{
 		value_normalized = toNormalized (value);
@@ -303,55 +381,122 @@ inline bool parameter::fromString (const tchar* string, param_value& value_norma
 //------------------------------------------------------------------------
 inline auto parameter::toPlain (param_value valueNormalized) const -> param_value
 {
-	if (to_plain)
-		return to_plain (*this, valueNormalized);
-	if (auto stepCount = std::get_if<param::step_count> (&desc.range_or_step_count))
-	{
-		return normalized_to_steps (stepCount->num_steps, stepCount->start_value, valueNormalized);
-	}
-	auto range = std::get<param::range> (desc.range_or_step_count);
-	return normalized_to_plain (range.min, range.max, valueNormalized);
+	if (ext && ext->to_plain)
+		return ext->to_plain (*this, valueNormalized);
+	if (desc.convert.to_plain)
+		return desc.convert.to_plain (valueNormalized);
+	if (range)
+		return normalized_to_plain (range->min, range->max, valueNormalized);
+	return steps.to_steps (valueNormalized);
 }
 
 //------------------------------------------------------------------------
 inline auto parameter::toNormalized (param_value plainValue) const -> param_value
 {
-	if (to_normalized)
-		return to_normalized (*this, plainValue);
-	if (auto stepCount = std::get_if<param::step_count> (&desc.range_or_step_count))
-	{
-		return steps_to_normalized (stepCount->num_steps, stepCount->start_value, plainValue);
-	}
-	auto range = std::get<param::range> (desc.range_or_step_count);
-	return plain_to_normalized (range.min, range.max, plainValue);
+	if (ext && ext->to_normalized)
+		return ext->to_normalized (*this, plainValue);
+	if (desc.convert.to_normalized)
+		return desc.convert.to_normalized (plainValue);
+	if (range)
+		return plain_to_normalized (range->min, range->max, plainValue);
+	return steps_to_normalized (steps.steps (), steps.start (), plainValue);
 }
 
 //------------------------------------------------------------------------
 inline void parameter::changed (Steinberg::int32 msg)
 {
 	Steinberg::Vst::Parameter::changed (msg);
-	if (msg == kChanged)
+	if (msg != kChanged || !ext)
+		return;
+	if (ext->batcher)
 	{
-		++iterating_listeners;
-		std::for_each (listeners.begin (), listeners.end (),
-					   [this] (const auto& p) { p.first (*this, getNormalized ()); });
-		--iterating_listeners;
-		if (iterating_listeners == 0)
+		if (!ext->notification_pending)
 		{
-			if (!listeners_to_add.empty ())
-			{
-				std::move (listeners_to_add.begin (), listeners_to_add.end (),
-						   std::back_inserter (listeners));
-				listeners_to_add.clear ();
-			}
-			if (!listeners_to_remove.empty ())
-			{
-				std::for_each (listeners_to_remove.begin (), listeners_to_remove.end (),
-							   [&] (auto& el) { remove_listener (el); });
-			}
+			ext->notification_pending = true;
+			ext->batcher->pending.push_back (this);
+		}
+		return;
+	}
+	notify_listeners ();
+}
+
+//------------------------------------------------------------------------
+inline void parameter::notify_listeners ()
+{
+	auto& e = *ext;
+	++e.iterating_listeners;
+	std::for_each (e.listeners.begin (), e.listeners.end (),
+				   [this] (const auto& p) { p.first (*this, getNormalized ()); });
+	--e.iterating_listeners;
+	if (e.iterating_listeners == 0)
+	{
+		if (!e.listeners_to_add.empty ())
+		{
+			std::move (e.listeners_to_add.begin (), e.listeners_to_add.end (),
+					   std::back_inserter (e.listeners));
+			e.listeners_to_add.clear ();
+		}
+		if (!e.listeners_to_remove.empty ())
+		{
+			std::for_each (e.listeners_to_remove.begin (), e.listeners_to_remove.end (),
+						   [&] (auto& el) { remove_listener (el); });
+			e.listeners_to_remove.clear ();
 		}
 	}
 }
 
+//------------------------------------------------------------------------
+inline void parameter::set_notification_batcher (notification_batcher* batcher)
+{
+	auto& e = get_extension ();
+	if (e.batcher == batcher)
+		return;
+	if (e.notification_pending)
+	{
+		e.batcher->remove (this);
+		e.notification_pending = false;
+		notify_listeners ();
+	}
+	e.batcher = batcher;
+}
+
+//------------------------------------------------------------------------
+inline parameter::~parameter () noexcept
+{
+	if (ext && ext->notification_pending)
+		ext->batcher->remove (this);
+}
+
+//------------------------------------------------------------------------
+inline void notification_batcher::flush ()
+{
+	processing.swap (pending);
+	// the listeners may destroy or detach parameters which are still waiting, these entries are
+	// set to nullptr by remove
+	for (size_t index = 0u; index < processing.size (); ++index)
+	{
+		auto param = processing[index];
+		if (param == nullptr)
+			continue;
+		param->ext->notification_pending = false;
+		param->notify_listeners ();
+	}
+	processing.clear ();
+}
+
+//------------------------------------------------------------------------
+inline void notification_batcher::remove (parameter* param) noexcept
+{
+	auto it = std::find (pending.begin (), pending.end (), param);
+	if (it != pending.end ())
+	{
+		pending.erase (it);
+		return;
+	}
+	it = std::find (processing.begin (), processing.end (), param);
+	if (it != processing.end ())
+		*it = nullptr;
+}
+
 //------------------------------------------------------------------------
 } // vst3utils
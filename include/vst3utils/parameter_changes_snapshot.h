@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/parameter_changes_iterator.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** flat copy of all points of IParameterChanges
+
+capture drains all queues of a block in one pass into contiguous arrays of parameter ids, sample
+offsets and values, so that the changes can be scanned several times without any virtual call.
+
+the points are in queue order (and ordered by sample offset within a queue) or sorted by sample
+offset over all queues. Points with the same sample offset keep their queue order.
+
+the storage is allocated by setup, capture never allocates. Points which do not fit are dropped
+and reported by capture.
+
+Example:
+
+	parameter_changes_snapshot snapshot;
+
+	// in setupProcessing
+	snapshot.setup (num_parameters * 8);
+
+	// in process
+	if (data.inputParameterChanges)
+		snapshot.capture (data.inputParameterChanges, true);
+	for (size_t i = 0; i < snapshot.size (); ++i)
+		handle (snapshot.pid (i), snapshot.sample_offset (i), snapshot.value (i));
+
+ */
+class parameter_changes_snapshot
+{
+public:
+	using IParameterChanges = Steinberg::Vst::IParameterChanges;
+	using ParamID = Steinberg::Vst::ParamID;
+	using ParamValue = Steinberg::Vst::ParamValue;
+	using int32 = Steinberg::int32;
+
+	/** allocate the storage for up to max_points points per block */
+	void setup (size_t max_points)
+	{
+		pids.resize (max_points);
+		offsets.resize (max_points);
+		values.resize (max_points);
+		order.resize (max_points);
+		scratch_pids.resize (max_points);
+		scratch_offsets.resize (max_points);
+		scratch_values.resize (max_points);
+		count = 0u;
+	}
+
+	/** copy all points of the changes, the previous content is replaced
+	 *
+	 *	@param changes the parameter changes of the block, may be nullptr
+	 *	@param sort_by_offset sort the points of all queues by their sample offset
+	 *	@return true if all points were copied, false if points were dropped
+	 */
+	bool capture (IParameterChanges* changes, bool sort_by_offset = false) noexcept
+	{
+		count = 0u;
+		bool complete = true;
+		if (changes == nullptr)
+			return complete;
+		for (auto it = begin (changes), end_it = end (changes); it != end_it; ++it)
+		{
+			auto queue = *it;
+			auto pid = queue->getParameterId ();
+			auto num_points = queue->getPointCount ();
+			for (int32 index = 0; index < num_points; ++index)
+			{
+				if (count == capacity ())
+				{
+					complete = false;
+					break;
+				}
+				if (queue->getPoint (index, offsets[count], values[count]) !=
+					Steinberg::kResultTrue)
+					continue;
+				pids[count] = pid;
+				++count;
+			}
+		}
+		if (sort_by_offset)
+			sort ();
+		return complete;
+	}
+
+	/** remove all points */
+	void clear () noexcept { count = 0u; }
+
+	/** returns the number of points of the last capture */
+	size_t size () const noexcept { return count; }
+	/** returns true if the last capture had no points */
+	bool empty () const noexcept { return count == 0u; }
+	/** returns the maximum number of points */
+	size_t capacity () const noexcept { return pids.size (); }
+
+	ParamID pid (size_t index) const noexcept { return pids[index]; }
+	int32 sample_offset (size_t index) const noexcept { return offsets[index]; }
+	ParamValue value (size_t index) const noexcept { return values[index]; }
+
+	const ParamID* pid_data () const noexcept { return pids.data (); }
+	const int32* sample_offset_data () const noexcept { return offsets.data (); }
+	const ParamValue* value_data () const noexcept { return values.data (); }
+
+private:
+	void sort () noexcept
+	{
+		if (std::is_sorted (offsets.begin (), offsets.begin () + count))
+			return;
+		for (size_t i = 0u; i < count; ++i)
+			order[i] = static_cast<uint32_t> (i);
+		// the index as second key keeps the queue order of points with the same offset
+		std::sort (order.begin (), order.begin () + count, [this] (auto lhs, auto rhs) {
+			return offsets[lhs] < offsets[rhs] || (offsets[lhs] == offsets[rhs] && lhs < rhs);
+		});
+		for (size_t i = 0u; i < count; ++i)
+		{
+			scratch_pids[i] = pids[order[i]];
+			scratch_offsets[i] = offsets[order[i]];
+			scratch_values[i] = values[order[i]];
+		}
+		pids.swap (scratch_pids);
+		offsets.swap (scratch_offsets);
+		values.swap (scratch_values);
+	}
+
+	std::vector<ParamID> pids;
+	std::vector<int32> offsets;
+	std::vector<ParamValue> values;
+	std::vector<uint32_t> order;
+	std::vector<ParamID> scratch_pids;
+	std::vector<int32> scratch_offsets;
+	std::vector<ParamValue> scratch_values;
+	size_t count {0u};
+};
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -11,6 +11,8 @@
 #include "vst3utils/norm_plain_conversion.h"
 #include <variant>
 #include <array>
+#include <algorithm>
+#include <cstddef>
 
 //------------------------------------------------------------------------
 namespace vst3utils {
@@ -36,7 +38,8 @@ struct range
 /** Parameter step count description
 
 describes a parameter with a concret number of steps. if a string_list is provided the number of
-strings must be equal to the number of steps.
+strings must be equal to the number of steps. The string_list must have static storage duration, as
+parameter shares one string_list_index per list for the whole program.
 
  */
 struct step_count
@@ -100,13 +103,17 @@ inline constexpr convert_func make_normalized_to_steps_func ()
 	};
 }
 
+//------------------------------------------------------------------------
+/** the exp_mapping used by the exponent convert functions, computed at compile time */
+template<int32_t min, int32_t max>
+inline constexpr exp_mapping<double> exp_mapping_v {static_cast<double> (min),
+												   static_cast<double> (max)};
+
 //------------------------------------------------------------------------
 template<int32_t min, int32_t max>
 inline constexpr convert_func make_normalized_to_exp_func ()
 {
-	return [] (double v) {
-		return normalized_to_exp (static_cast<double> (min), static_cast<double> (max), v);
-	};
+	return [] (double v) { return exp_mapping_v<min, max>.to_plain (v); };
 }
 
 //------------------------------------------------------------------------
@@ -131,9 +138,7 @@ inline constexpr convert_func make_steps_to_normalized_func ()
 template<int32_t min, int32_t max>
 inline constexpr convert_func make_exp_to_normalized_func ()
 {
-	return [] (double v) {
-		return exp_to_normalized (static_cast<double> (min), static_cast<double> (max), v);
-	};
+	return [] (double v) { return exp_mapping_v<min, max>.to_normalized (v); };
 }
 
 //------------------------------------------------------------------------
@@ -180,6 +185,90 @@ inline constexpr convert_functions db_functions ()
 	return {make_normalized_to_db_func (), make_db_to_normalized_func ()};
 }
 
+//------------------------------------------------------------------------
+/** compile time lookup table for a normalized to plain convert function
+
+samples the convert function returned by make_func at num_points equidistant normalized values at
+compile time and converts with linear interpolation between them, so the audio thread does one
+table read and one multiply-add instead of evaluating transcendental functions.
+
+make_func is one of the make_*_func functions above or any other constexpr function returning a
+convert_func which is usable in constant expressions (a function is needed as template argument
+because the function pointer of a lambda is not a valid template argument).
+
+max_error is the largest deviation from the convert function at the midpoints between the table
+points, which is where the interpolation error of smooth curves is largest. Use it to choose
+num_points:
+
+	using cutoff_table = lookup_table<make_normalized_to_exp_func<20, 20000>, 512>;
+	static_assert (cutoff_table::max_error < 0.5);
+
+ */
+template<convert_func (*make_func) (), size_t num_points = 256>
+struct lookup_table
+{
+	static_assert (num_points >= 2u, "a lookup table needs at least two points");
+
+	static constexpr convert_func func = make_func ();
+
+	static constexpr std::array<double, num_points> make_values () noexcept
+	{
+		std::array<double, num_points> result {};
+		for (size_t i = 0u; i < num_points; ++i)
+			result[i] = func (static_cast<double> (i) / static_cast<double> (num_points - 1u));
+		return result;
+	}
+
+	static constexpr auto values = make_values ();
+
+	/** convert a normalized value with linear interpolation, the input is clamped to [0..1] */
+	static constexpr double to_plain (double normalized_value) noexcept
+	{
+		auto x = std::clamp (normalized_value, 0., 1.) * static_cast<double> (num_points - 1u);
+		auto index = std::min (static_cast<size_t> (x), num_points - 2u);
+		auto fraction = x - static_cast<double> (index);
+		return values[index] + fraction * (values[index + 1u] - values[index]);
+	}
+
+	static constexpr double compute_max_error () noexcept
+	{
+		double result = 0.;
+		for (size_t i = 0u; i < num_points - 1u; ++i)
+		{
+			auto norm = (static_cast<double> (i) + 0.5) / static_cast<double> (num_points - 1u);
+			auto error = func (norm) - to_plain (norm);
+			result = std::max (result, error < 0. ? -error : error);
+		}
+		return result;
+	}
+
+	static constexpr double max_error = compute_max_error ();
+};
+
+//------------------------------------------------------------------------
+template<convert_func (*make_func) (), size_t num_points = 256>
+inline constexpr convert_func make_lookup_table_func ()
+{
+	return [] (double v) { return lookup_table<make_func, num_points>::to_plain (v); };
+}
+
+//------------------------------------------------------------------------
+/** convert functions which use a lookup table for to_plain and the exact to_normalized
+ *
+ *	Example:
+ *
+ *	constexpr auto cutoff_functions =
+ *		lookup_table_functions<make_normalized_to_exp_func<20, 20000>,
+ *							   make_exp_to_normalized_func<20, 20000>, 512> ();
+ *	range_description (u"cutoff", 1000., cutoff_functions, 0, u"Hz");
+ */
+template<convert_func (*make_to_plain) (), convert_func (*make_to_normalized) (),
+		 size_t num_points = 256>
+inline constexpr convert_functions lookup_table_functions ()
+{
+	return {make_lookup_table_func<make_to_plain, num_points> (), make_to_normalized ()};
+}
+
 //------------------------------------------------------------------------
 template<typename array_t>
 inline constexpr description list_description (const char16_t* name, uint32_t default_index,
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/buffer_ops.h"
+#include "vst3utils/parameter_changes_iterator.h"
+#include <algorithm>
+#include <cassert>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** sample accurate parameter ramp
+
+renders the points of an IParamValueQueue as an exact piecewise linear curve with one value per
+sample into an aligned buffer. The value of the previous block is the start point one sample
+before the block, every point of the queue is reached exactly at its sample offset and the value
+of the last point is held until the end of the block.
+
+the segments between the points are filled with simd, so the DSP can read the curve without any
+per sample branching.
+
+Example:
+
+	parameter_ramp<float> gain_ramp;
+
+	// in setupProcessing
+	gain_ramp.setup (setup.maxSamplesPerBlock);
+
+	// in process
+	gain_ramp.process (gain_queue, data.numSamples); // gain_queue may be nullptr
+	auto gain = gain_ramp.data ();
+	for (auto i = 0; i < data.numSamples; ++i)
+		out[i] = in[i] * gain[i];
+
+ */
+template<typename T, size_t alignment = cache_line_size>
+struct parameter_ramp
+{
+	using IParamValueQueue = Steinberg::Vst::IParamValueQueue;
+	using int32 = Steinberg::int32;
+
+	parameter_ramp (T initial_value = {}) : last_value (initial_value) {}
+
+	/** allocate the curve buffer for blocks of up to max_block_size samples */
+	void setup (size_t max_block_size) { curve.allocate (max_block_size); }
+
+	/** set the current value without ramping */
+	void set_value (T v) noexcept { last_value = v; }
+	/** returns the value at the end of the last processed block */
+	T get_value () const noexcept { return last_value; }
+
+	/** render the curve for the next num_samples samples
+	 *
+	 *	@param queue the parameter queue of this block or nullptr if the parameter did not change
+	 *	@return pointer to the curve, valid until the next call
+	 */
+	const T* process (IParamValueQueue* queue, int32 num_samples) noexcept
+	{
+		assert (num_samples >= 0 && static_cast<size_t> (num_samples) <= curve.capacity ());
+		num_samples = std::min (num_samples, static_cast<int32> (curve.capacity ()));
+		curve.allocate (static_cast<size_t> (num_samples));
+		auto out = curve.data ();
+
+		constant = true;
+		int32 pos = -1;
+		if (queue && num_samples > 0)
+		{
+			for (auto it = begin (queue), end_it = end (queue); it != end_it; ++it)
+			{
+				auto offset = std::clamp ((*it).sample_offset, 0, num_samples - 1);
+				auto value = static_cast<T> ((*it).value);
+				if (offset > pos)
+				{
+					auto length = offset - pos;
+					auto increment = (value - last_value) / static_cast<T> (length);
+					if (length > 1)
+						fill_ramp (out + pos + 1, static_cast<size_t> (length - 1),
+								   last_value + increment, increment);
+					pos = offset;
+				}
+				constant = constant && value == last_value;
+				out[pos] = last_value = value;
+			}
+		}
+		if (pos + 1 < num_samples)
+			fill (out + pos + 1, static_cast<size_t> (num_samples - pos - 1), last_value);
+		return out;
+	}
+
+	/** returns the curve of the last processed block */
+	const T* data () const noexcept { return curve.data (); }
+	/** returns the number of samples of the last processed block */
+	size_t size () const noexcept { return curve.size (); }
+	/** returns true if all values of the last processed block are the same */
+	bool is_constant () const noexcept { return constant; }
+
+private:
+	aligned_buffer<T, alignment> curve;
+	T last_value {};
+	bool constant {true};
+};
+
+//------------------------------------------------------------------------
+} // vst3utils
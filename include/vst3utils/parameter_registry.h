@@ -0,0 +1,296 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/parameter_description.h"
+#include "pluginterfaces/vst/ivsteditcontroller.h"
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** a table of parameters computed from an array of param::description
+
+the id, flags, step count and default values of every parameter are computed once, at compile time
+if the registry is constexpr. A perfect hash maps the parameter ids to the index of the
+description, so sparse ids are found with two table reads and one compare.
+
+the same registry can be used by the edit controller to create its parameters and by the
+processor to map the parameter ids of IParameterChanges to its own tables.
+
+the descriptions must outlive the registry (usually both are static). Very large registries may
+exceed the constexpr evaluation limits of the compiler, use a static const registry for these, it
+is computed once at static initialization.
+
+Example:
+
+	static constexpr std::array<param::description, 3> descriptions = {{
+		param::list_description (u"bypass", 0, param::strings_on_off),
+		param::range_description (u"gain", 0., param::linear_functions<-60, 12> (), 1, u"dB"),
+		param::range_description (u"pan", 0., param::linear_functions<-100, 100> (), 0),
+	}};
+	static constexpr std::array<Steinberg::Vst::ParamID, 3> ids = {100, 2000, 30000};
+	static constexpr parameter_registry registry {descriptions, ids};
+
+	// in the edit controller
+	for (const auto& entry : registry)
+		parameters.addParameter (new parameter (entry.id, *entry.description, entry.flags));
+
+	// in the processor
+	auto index = registry.index_of (queue->getParameterId ());
+	if (index < registry.size ())
+		...
+
+ */
+template<size_t N>
+class parameter_registry
+{
+public:
+	using param_id = Steinberg::Vst::ParamID;
+	using param_value = Steinberg::Vst::ParamValue;
+	using Flags = Steinberg::Vst::ParameterInfo::ParameterFlags;
+
+	struct entry
+	{
+		param_id id {};
+		int32_t flags {};
+		int32_t step_count {};
+		param_value default_normalized {};
+		param_value default_plain {};
+		const param::description* description {nullptr};
+	};
+
+	/** create the registry with the ids of the parameters, ids must be unique */
+	constexpr parameter_registry (const std::array<param::description, N>& descriptions,
+								  const std::array<param_id, N>& ids,
+								  int32_t flags = Flags::kCanAutomate) noexcept
+	{
+		for (size_t index = 0u; index < N; ++index)
+			entries[index] = make_entry (descriptions[index], ids[index], flags);
+		build_hash ();
+	}
+
+	/** create the registry with the index of the description as parameter id */
+	constexpr parameter_registry (const std::array<param::description, N>& descriptions,
+								  int32_t flags = Flags::kCanAutomate) noexcept
+	{
+		for (size_t index = 0u; index < N; ++index)
+			entries[index] = make_entry (descriptions[index], static_cast<param_id> (index), flags);
+		build_hash ();
+	}
+
+	/** returns the index of the parameter or size () if the id is unknown */
+	constexpr size_t index_of (param_id id) const noexcept
+	{
+		auto bucket = hash (id, 0u) & (num_buckets - 1u);
+		auto slot = hash (id, seeds[bucket]) & (num_slots - 1u);
+		size_t index = slots[slot];
+		return index < N && entries[index].id == id ? index : N;
+	}
+	/** returns the entry of the parameter or nullptr if the id is unknown */
+	constexpr const entry* find (param_id id) const noexcept
+	{
+		auto index = index_of (id);
+		return index < N ? &entries[index] : nullptr;
+	}
+
+	constexpr size_t size () const noexcept { return N; }
+	constexpr const entry& operator[] (size_t index) const noexcept { return entries[index]; }
+	constexpr const entry* begin () const noexcept { return entries.data (); }
+	constexpr const entry* end () const noexcept { return entries.data () + N; }
+
+	/** convert the normalized value of the parameter at index to its plain value
+	 *
+	 *	uses the convert functions of the description like parameter does without custom functions
+	 */
+	constexpr param_value to_plain (size_t index, param_value normalized) const noexcept
+	{
+		return description_to_plain (*entries[index].description, normalized);
+	}
+
+	/** fill a ParameterInfo with the precomputed values of the parameter at index */
+	Steinberg::Vst::ParameterInfo info (size_t index) const noexcept
+	{
+		const auto& e = entries[index];
+		Steinberg::Vst::ParameterInfo result {};
+		result.id = e.id;
+		result.flags = e.flags;
+		result.stepCount = e.step_count;
+		result.defaultNormalizedValue = e.default_normalized;
+		result.unitId = Steinberg::Vst::kRootUnitId;
+		copy_string (e.description->name, result.title);
+		if (auto step_count = std::get_if<param::step_count> (&e.description->range_or_step_count))
+			copy_string (step_count->unit, result.units);
+		else if (auto range = std::get_if<param::range> (&e.description->range_or_step_count))
+			copy_string (range->unit, result.units);
+		return result;
+	}
+
+private:
+	using index_t = std::conditional_t<(N < 0xffffu), uint16_t, uint32_t>;
+
+	static constexpr size_t next_pow2 (size_t value) noexcept
+	{
+		size_t result = 1u;
+		while (result < value)
+			result <<= 1u;
+		return result;
+	}
+
+	/** about 4 ids per bucket, the slot table is 1.5 to 3 times as large as the number of ids */
+	static constexpr size_t num_buckets = next_pow2 (N / 4u + 1u);
+	static constexpr size_t num_slots = next_pow2 (N + N / 2u + 1u);
+
+	static constexpr uint32_t hash (param_id id, uint32_t seed) noexcept
+	{
+		uint32_t h = id + seed * 0x9e3779b9u;
+		h ^= h >> 16u;
+		h *= 0x85ebca6bu;
+		h ^= h >> 13u;
+		h *= 0xc2b2ae35u;
+		h ^= h >> 16u;
+		return h;
+	}
+
+	static constexpr entry make_entry (const param::description& desc, param_id id,
+									   int32_t flags) noexcept
+	{
+		entry e {id, flags, 0, desc.default_normalized, 0., &desc};
+		if (auto step_count = std::get_if<param::step_count> (&desc.range_or_step_count))
+		{
+			e.step_count = static_cast<int32_t> (step_count->num_steps);
+			if (step_count->string_list)
+				e.flags |= Flags::kIsList;
+		}
+		e.default_plain = description_to_plain (desc, desc.default_normalized);
+		return e;
+	}
+
+	static constexpr param_value description_to_plain (const param::description& desc,
+													   param_value normalized) noexcept
+	{
+		if (desc.convert.to_plain)
+			return desc.convert.to_plain (normalized);
+		if (auto range = std::get_if<param::range> (&desc.range_or_step_count))
+			return normalized_to_plain (range->min, range->max, normalized);
+		const auto& step_count = std::get<param::step_count> (desc.range_or_step_count);
+		return step_mapping (static_cast<int32_t> (step_count.num_steps), step_count.start_value)
+			.to_steps (normalized);
+	}
+
+	/** hash and displace: the ids are distributed into buckets, starting with the largest bucket
+	 *	a seed is searched for every bucket which maps all its ids to free slots
+	 */
+	constexpr void build_hash () noexcept
+	{
+		std::array<size_t, num_buckets + 1u> bucket_start {};
+		std::array<index_t, N> order {};
+		for (size_t index = 0u; index < N; ++index)
+			++bucket_start[(hash (entries[index].id, 0u) & (num_buckets - 1u)) + 1u];
+		size_t max_bucket_size = 0u;
+		for (size_t bucket = 0u; bucket < num_buckets; ++bucket)
+		{
+			if (bucket_start[bucket + 1u] > max_bucket_size)
+				max_bucket_size = bucket_start[bucket + 1u];
+			bucket_start[bucket + 1u] += bucket_start[bucket];
+		}
+		std::array<size_t, num_buckets> fill {};
+		for (size_t index = 0u; index < N; ++index)
+		{
+			auto bucket = hash (entries[index].id, 0u) & (num_buckets - 1u);
+			order[bucket_start[bucket] + fill[bucket]++] = static_cast<index_t> (index);
+		}
+		for (auto& slot : slots)
+			slot = static_cast<index_t> (N);
+
+		for (auto bucket_size = max_bucket_size; bucket_size > 0u; --bucket_size)
+		{
+			for (size_t bucket = 0u; bucket < num_buckets; ++bucket)
+			{
+				auto first = bucket_start[bucket];
+				if (bucket_start[bucket + 1u] - first != bucket_size)
+					continue;
+				remove_duplicates (order, first, bucket_size);
+				for (uint32_t seed = 1u;; ++seed)
+				{
+					if (place (order, first, bucket_size, seed))
+					{
+						seeds[bucket] = seed;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	/** duplicate ids always share a bucket, all but the first one are ignored */
+	constexpr void remove_duplicates (std::array<index_t, N>& order, size_t first,
+									  size_t count) noexcept
+	{
+		for (size_t i = first + 1u; i < first + count; ++i)
+		{
+			for (size_t j = first; j < i; ++j)
+			{
+				if (order[j] != N && order[i] != N &&
+					entries[order[i]].id == entries[order[j]].id)
+				{
+					assert (false && "duplicate parameter id");
+					order[i] = static_cast<index_t> (N);
+				}
+			}
+		}
+	}
+
+	constexpr bool place (const std::array<index_t, N>& order, size_t first, size_t count,
+						  uint32_t seed) noexcept
+	{
+		for (size_t i = first; i < first + count; ++i)
+		{
+			if (order[i] == N)
+				continue;
+			auto slot = hash (entries[order[i]].id, seed) & (num_slots - 1u);
+			if (slots[slot] != N)
+			{
+				// undo the slots of this bucket placed so far
+				for (size_t j = first; j < i; ++j)
+				{
+					if (order[j] != N)
+						slots[hash (entries[order[j]].id, seed) & (num_slots - 1u)] =
+							static_cast<index_t> (N);
+				}
+				return false;
+			}
+			slots[slot] = order[i];
+		}
+		return true;
+	}
+
+	template<size_t size>
+	static void copy_string (const char16_t* source, Steinberg::Vst::TChar (&dest)[size]) noexcept
+	{
+		size_t i = 0u;
+		if (source)
+		{
+			for (; i < size - 1u && source[i] != 0; ++i)
+				dest[i] = static_cast<Steinberg::Vst::TChar> (source[i]);
+		}
+		dest[i] = 0;
+	}
+
+	std::array<entry, N> entries {};
+	std::array<uint32_t, num_buckets> seeds {};
+	std::array<index_t, num_slots> slots {};
+};
+
+//------------------------------------------------------------------------
+} // vst3utils
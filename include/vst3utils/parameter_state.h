@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/buffer.h"
+#include "vst3utils/parameter_changes_iterator.h"
+#include "vst3utils/parameter_registry.h"
+#include "vst3utils/simd.h"
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** realtime parameter state of the audio processor
+
+holds the normalized and the plain values of all parameters of a parameter_registry in contiguous
+arrays and a bitset of the parameters which changed since the last call to clear_dirty.
+
+update takes the last point of every queue of IParameterChanges in one pass, so the DSP can ask
+which parameters changed and only recompute what depends on them. It does not allocate.
+
+all parameters are dirty after construction and reset, so everything is computed in the first
+block.
+
+Example:
+
+	parameter_state<num_parameters> state {registry};
+
+	// in process
+	if (data.inputParameterChanges)
+		state.update (data.inputParameterChanges);
+	state.for_each_dirty ([&] (size_t index) {
+		switch (index)
+		{
+			case gain_index: gain = db_to_gain (state.plain (index)); break;
+			...
+		}
+	});
+	state.clear_dirty ();
+
+ */
+template<size_t N>
+class parameter_state
+{
+public:
+	using param_id = Steinberg::Vst::ParamID;
+	using param_value = Steinberg::Vst::ParamValue;
+	using IParameterChanges = Steinberg::Vst::IParameterChanges;
+
+	explicit parameter_state (const parameter_registry<N>& registry) noexcept : registry (registry)
+	{
+		reset ();
+	}
+
+	/** set all parameters to their default value and mark them dirty */
+	void reset () noexcept
+	{
+		for (size_t index = 0u; index < N; ++index)
+		{
+			normalized_values[index] = registry[index].default_normalized;
+			plain_values[index] = registry[index].default_plain;
+		}
+		dirty.fill (~uint64_t (0));
+		if constexpr (N % 64u != 0u)
+			dirty.back () = (uint64_t (1) << (N % 64u)) - 1u;
+	}
+
+	/** take the last value of every queue of the changes of this block
+	 *
+	 *	@return the number of parameters whose value changed
+	 */
+	size_t update (IParameterChanges* changes) noexcept
+	{
+		size_t num_changed = 0u;
+		for (auto it = begin (changes), end_it = end (changes); it != end_it; ++it)
+		{
+			auto queue = *it;
+			auto index = registry.index_of (queue->getParameterId ());
+			if (index >= N)
+				continue;
+			Steinberg::int32 offset;
+			param_value value;
+			if (queue->getPoint (queue->getPointCount () - 1, offset, value) !=
+				Steinberg::kResultTrue)
+				continue;
+			if (set_normalized (index, value))
+				++num_changed;
+		}
+		return num_changed;
+	}
+
+	/** set the normalized value of the parameter at index
+	 *
+	 *	@return true and mark the parameter dirty if the value changed
+	 */
+	bool set_normalized (size_t index, param_value value) noexcept
+	{
+		assert (index < N);
+		if (normalized_values[index] == value)
+			return false;
+		normalized_values[index] = value;
+		plain_values[index] = registry.to_plain (index, value);
+		dirty[index / 64u] |= uint64_t (1) << (index % 64u);
+		return true;
+	}
+
+	param_value normalized (size_t index) const noexcept { return normalized_values[index]; }
+	param_value plain (size_t index) const noexcept { return plain_values[index]; }
+	const param_value* normalized_data () const noexcept { return normalized_values.data (); }
+	const param_value* plain_data () const noexcept { return plain_values.data (); }
+	constexpr size_t size () const noexcept { return N; }
+
+	/** returns true if the parameter at index changed since the last clear_dirty */
+	bool is_dirty (size_t index) const noexcept
+	{
+		return (dirty[index / 64u] >> (index % 64u)) & 1u;
+	}
+	/** returns true if any parameter changed since the last clear_dirty */
+	bool any_dirty () const noexcept
+	{
+		for (auto word : dirty)
+		{
+			if (word)
+				return true;
+		}
+		return false;
+	}
+	/** call proc (index) for every dirty parameter in ascending order */
+	template<typename Proc>
+	void for_each_dirty (Proc&& proc) const
+	{
+		for (size_t w = 0u; w < dirty.size (); ++w)
+		{
+			for (auto word = dirty[w]; word != 0u; word &= word - 1u)
+				proc (w * 64u + detail::count_trailing_zeros (word));
+		}
+	}
+	/** mark all parameters as unchanged */
+	void clear_dirty () noexcept { dirty.fill (0u); }
+
+private:
+	const parameter_registry<N>& registry;
+	alignas (cache_line_size) std::array<param_value, N> normalized_values {};
+	alignas (cache_line_size) std::array<param_value, N> plain_values {};
+	std::array<uint64_t, (N + 63u) / 64u> dirty {};
+};
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/byteorder_stream.h"
+#include "vst3utils/parameter.h"
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** applies a whole set of normalized values to parameters in one pass
+
+all values are set first, the listeners of the changed parameters are called afterwards, once
+per parameter and with all values of the preset already set. Parameters using their own
+notification_batcher keep it, their notifications are delivered when that batcher is flushed.
+
+the indices of the changed parameters are available via changed () until the next apply. The
+loader keeps its buffers, so applying presets of the same size does not allocate.
+
+Example:
+
+	// in the edit controller
+	std::vector<parameter*> my_parameters; // filled in initialize
+	preset_loader loader;
+
+	tresult PLUGIN_API setComponentState (IBStream* state) override
+	{
+		auto stream = make_byte_order_stream<byte_order::little_endian> (state);
+		if (!loader.apply (my_parameters.data (), my_parameters.size (), stream))
+			return kResultFalse;
+		for (auto index : loader.changed ())
+			...
+		return kResultTrue;
+	}
+
+ */
+class preset_loader
+{
+public:
+	using param_value = parameter::param_value;
+
+	/** set parameters[i] to normalized[i] for all count parameters, nullptr parameters are skipped
+	 *
+	 *	@return the number of parameters whose value changed
+	 */
+	inline size_t apply (parameter* const* parameters, const param_value* normalized, size_t count);
+
+	/** read count normalized values as doubles from the stream and apply them
+	 *
+	 *	@return false and leave the parameters untouched if the stream could not be read
+	 */
+	template<byte_order stream_byte_order, bool throw_on_error>
+	bool apply (parameter* const* parameters, size_t count,
+				const byte_order_ibstream<stream_byte_order, throw_on_error>& stream)
+	{
+		values.resize (count);
+		auto result = stream.read (values.data (), count);
+		if (!result || result.bytes != count * sizeof (param_value))
+			return false;
+		apply (parameters, values.data (), count);
+		return true;
+	}
+
+	/** returns the indices of the parameters changed by the last apply in ascending order */
+	const std::vector<uint32_t>& changed () const noexcept { return changed_indices; }
+
+private:
+	notification_batcher batcher;
+	std::vector<parameter*> deferred;
+	std::vector<uint32_t> changed_indices;
+	std::vector<param_value> values;
+};
+
+//------------------------------------------------------------------------
+inline size_t preset_loader::apply (parameter* const* parameters, const param_value* normalized,
+									size_t count)
+{
+	changed_indices.clear ();
+	deferred.clear ();
+	for (size_t index = 0u; index < count; ++index)
+	{
+		auto param = parameters[index];
+		if (!param)
+			continue;
+		// only parameters with listeners have an extension, there is nothing to defer for others
+		if (param->ext && param->ext->batcher == nullptr)
+		{
+			param->ext->batcher = &batcher;
+			deferred.push_back (param);
+		}
+		if (param->setNormalized (normalized[index]))
+			changed_indices.push_back (static_cast<uint32_t> (index));
+	}
+	for (auto param : deferred)
+		param->ext->batcher = nullptr;
+	batcher.flush ();
+	return changed_indices.size ();
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/buffer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(MFD_CLOEXEC)
+#define VST3UTILS_RING_BUFFER_MIRRORED 1
+#endif
+#endif
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** ring buffer for delay lines and lookahead buffers
+ *
+ *	any contiguous read of up to capacity () samples is a plain pointer range, so no wrap around
+ *	handling is needed when reading and simd loads can be used.
+ *
+ *	on Linux the same memory pages are mapped twice back to back, so the memory after the end of
+ *	the ring is the start of the ring. On other platforms or if the mapping fails every sample is
+ *	written twice into a buffer of twice the capacity.
+ *
+ *	the capacity is rounded up to a multiple of the page size when mirrored.
+ *
+ *	Example (delay line processing one block):
+ *
+ *		ring_buffer<float> delay_line;
+ *		delay_line.allocate (max_delay + max_block_size); // in setupProcessing
+ *
+ *		// in process, delay >= 0
+ *		delay_line.write (in, num_samples);
+ *		copy (delay_line.read_ptr (delay + num_samples), out, num_samples);
+ */
+template<typename T>
+class ring_buffer
+{
+public:
+	static_assert (std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+	ring_buffer (size_t min_capacity = 0, bool allow_mirroring = true)
+	: allow_mirroring (allow_mirroring)
+	{
+		allocate (min_capacity);
+	}
+	~ring_buffer () noexcept { deallocate (); }
+
+	ring_buffer (const ring_buffer&) = delete;
+	ring_buffer& operator= (const ring_buffer&) = delete;
+
+	/** allocate a ring of at least min_capacity samples, all samples are set to zero */
+	void allocate (size_t min_capacity)
+	{
+		deallocate ();
+		if (min_capacity == 0u)
+			return;
+		if (!(allow_mirroring && map_mirrored (min_capacity)))
+		{
+			fallback.allocate (min_capacity * 2u);
+			if (fallback.size () == 0u)
+				return;
+			ring = fallback.data ();
+			ring_capacity = min_capacity;
+		}
+		clear ();
+	}
+
+	/** set all samples to zero and the write position to the start */
+	void clear () noexcept
+	{
+		if (ring)
+			std::fill_n (ring, ring_capacity * (mirrored ? 1u : 2u), T {});
+		write_pos = 0u;
+	}
+
+	/** write one sample */
+	void push (T value) noexcept
+	{
+		assert (ring);
+		ring[write_pos] = value;
+		if (!mirrored)
+			ring[write_pos + ring_capacity] = value;
+		if (++write_pos == ring_capacity)
+			write_pos = 0u;
+	}
+
+	/** write num_samples samples, num_samples must not be larger than the capacity */
+	void write (const T* in, size_t num_samples) noexcept
+	{
+		assert (ring);
+		assert (num_samples <= ring_capacity);
+		if (mirrored)
+		{
+			std::copy_n (in, num_samples, ring + write_pos);
+		}
+		else
+		{
+			auto first = std::min (num_samples, ring_capacity - write_pos);
+			std::copy_n (in, first, ring + write_pos);
+			std::copy_n (in, first, ring + write_pos + ring_capacity);
+			std::copy_n (in + first, num_samples - first, ring);
+			std::copy_n (in + first, num_samples - first, ring + ring_capacity);
+		}
+		write_pos += num_samples;
+		if (write_pos >= ring_capacity)
+			write_pos -= ring_capacity;
+	}
+
+	/** returns a pointer to the sample written age samples ago
+	 *
+	 *	age 1 is the most recently written sample, age must be in the range [1..capacity]. up to
+	 *	capacity () samples can be read contiguously from the returned pointer.
+	 */
+	const T* read_ptr (size_t age) const noexcept
+	{
+		assert (ring);
+		assert (age > 0u && age <= ring_capacity);
+		return ring + ((write_pos + ring_capacity - age) % ring_capacity);
+	}
+
+	/** returns the sample written age samples ago (age 1 is the most recent one) */
+	T operator[] (size_t age) const noexcept { return *read_ptr (age); }
+
+	/** returns the number of samples in the ring */
+	size_t capacity () const noexcept { return ring_capacity; }
+	/** returns true if the memory is mirrored by the operating system */
+	bool is_mirrored () const noexcept { return mirrored; }
+
+private:
+	void deallocate () noexcept
+	{
+#if defined(VST3UTILS_RING_BUFFER_MIRRORED)
+		if (mirrored)
+			munmap (ring, ring_capacity * sizeof (T) * 2u);
+#endif
+		fallback.release ();
+		ring = nullptr;
+		ring_capacity = write_pos = 0u;
+		mirrored = false;
+	}
+
+	bool map_mirrored (size_t min_capacity) noexcept
+	{
+#if defined(VST3UTILS_RING_BUFFER_MIRRORED)
+		auto page_size = static_cast<size_t> (sysconf (_SC_PAGESIZE));
+		if (page_size % sizeof (T) != 0u)
+			return false;
+		auto num_bytes = min_capacity * sizeof (T);
+		if (auto d = num_bytes % page_size; d != 0u)
+			num_bytes += page_size - d;
+
+		auto fd = memfd_create ("vst3utils_ring_buffer", MFD_CLOEXEC);
+		if (fd == -1)
+			return false;
+		void* address = MAP_FAILED;
+		if (ftruncate (fd, static_cast<off_t> (num_bytes)) == 0)
+			address = mmap (nullptr, num_bytes * 2u, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (address != MAP_FAILED)
+		{
+			auto base = static_cast<uint8_t*> (address);
+			auto first = mmap (base, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+			auto second = mmap (base + num_bytes, num_bytes, PROT_READ | PROT_WRITE,
+								MAP_SHARED | MAP_FIXED, fd, 0);
+			if (first != base || second != base + num_bytes)
+			{
+				munmap (address, num_bytes * 2u);
+				address = MAP_FAILED;
+			}
+		}
+		close (fd);
+		if (address == MAP_FAILED)
+			return false;
+		ring = static_cast<T*> (address);
+		ring_capacity = num_bytes / sizeof (T);
+		mirrored = true;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	aligned_buffer<T, cache_line_size> fallback;
+	T* ring {nullptr};
+	size_t ring_capacity {0u};
+	size_t write_pos {0u};
+	bool mirrored {false};
+	bool allow_mirroring {true};
+};
+
+//------------------------------------------------------------------------
+} // vst3utils
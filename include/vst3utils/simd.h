@@ -0,0 +1,567 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// define VST3UTILS_SIMD_SCALAR to disable all simd code paths
+#if defined(VST3UTILS_SIMD_SCALAR)
+#elif defined(__AVX2__)
+#define VST3UTILS_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VST3UTILS_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace simd {
+
+//------------------------------------------------------------------------
+/** scalar versions of the vector primitives
+ *
+ *	together with the friend functions of vec they allow to write kernels once as templates which
+ *	work with plain float and double values and with simd vectors.
+ */
+template<typename T>
+using enable_if_scalar_t = std::enable_if_t<std::is_floating_point_v<T>, T>;
+
+//------------------------------------------------------------------------
+template<typename T>
+inline enable_if_scalar_t<T> min (T a, T b) noexcept
+{
+	return std::min (a, b);
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+inline enable_if_scalar_t<T> max (T a, T b) noexcept
+{
+	return std::max (a, b);
+}
+
+//------------------------------------------------------------------------
+/** round to the nearest integer (ties to even like the vector versions), a must be in the range
+ *	of int64_t
+ */
+template<typename T>
+inline enable_if_scalar_t<T> nearest (T a) noexcept
+{
+	constexpr auto half = static_cast<T> (0.5);
+	auto i = static_cast<int64_t> (a);
+	auto r = a - static_cast<T> (i);
+	auto odd = (i & 1) != 0;
+	i += (r > half || (r == half && odd)) - (r < -half || (r == -half && odd));
+	return static_cast<T> (i);
+}
+
+//------------------------------------------------------------------------
+/** round towards zero, a must be in the range of int32_t */
+template<typename T>
+inline enable_if_scalar_t<T> truncate (T a) noexcept
+{
+	return static_cast<T> (static_cast<int32_t> (a));
+}
+
+//------------------------------------------------------------------------
+/** returns the unbiased binary exponent of a positive normal number as T */
+template<typename T>
+inline enable_if_scalar_t<T> exponent (T a) noexcept
+{
+	if constexpr (sizeof (T) == 4u)
+	{
+		uint32_t bits;
+		std::memcpy (&bits, &a, sizeof (bits));
+		return static_cast<T> (static_cast<int32_t> ((bits >> 23) & 0xffu) - 127);
+	}
+	else
+	{
+		uint64_t bits;
+		std::memcpy (&bits, &a, sizeof (bits));
+		return static_cast<T> (static_cast<int32_t> ((bits >> 52) & 0x7ffu) - 1023);
+	}
+}
+
+//------------------------------------------------------------------------
+/** returns the mantissa of a positive normal number in the range [1..2) */
+template<typename T>
+inline enable_if_scalar_t<T> mantissa (T a) noexcept
+{
+	if constexpr (sizeof (T) == 4u)
+	{
+		uint32_t bits;
+		std::memcpy (&bits, &a, sizeof (bits));
+		bits = (bits & 0x007fffffu) | 0x3f800000u;
+		std::memcpy (&a, &bits, sizeof (bits));
+	}
+	else
+	{
+		uint64_t bits;
+		std::memcpy (&bits, &a, sizeof (bits));
+		bits = (bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+		std::memcpy (&a, &bits, sizeof (bits));
+	}
+	return a;
+}
+
+//------------------------------------------------------------------------
+/** returns 2^n for an integral n in the exponent range of normal numbers */
+template<typename T>
+inline enable_if_scalar_t<T> pow2 (T n) noexcept
+{
+	T result;
+	if constexpr (sizeof (T) == 4u)
+	{
+		auto bits = static_cast<uint32_t> (static_cast<int32_t> (n) + 127) << 23;
+		std::memcpy (&result, &bits, sizeof (result));
+	}
+	else
+	{
+		auto bits = static_cast<uint64_t> (static_cast<int64_t> (n) + 1023) << 52;
+		std::memcpy (&result, &bits, sizeof (result));
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** native simd vector
+ *
+ *	a thin wrapper around the widest vector register type enabled at compile time (AVX2 or SSE2 on
+ *	x86, a single scalar value on all other platforms). It is used to write kernels once for all
+ *	instruction sets.
+ *
+ *	load and store require the pointer to be aligned to alignment, loadu and storeu don't.
+ *
+ *	the primary template is the scalar fallback with one lane.
+ */
+template<typename T>
+struct vec
+{
+	using value_type = T;
+	static constexpr size_t size = 1u;
+	static constexpr size_t alignment = alignof (T);
+
+	T v;
+
+	static vec load (const T* p) noexcept { return {*p}; }
+	static vec loadu (const T* p) noexcept { return {*p}; }
+	void store (T* p) const noexcept { *p = v; }
+	void storeu (T* p) const noexcept { *p = v; }
+	static vec set1 (T value) noexcept { return {value}; }
+	static vec zero () noexcept { return {T {0}}; }
+	/** returns the vector {start, start + step, start + 2 * step, ...} */
+	static vec ramp (T start, T) noexcept { return {start}; }
+
+	friend vec operator+ (vec a, vec b) noexcept { return {a.v + b.v}; }
+	friend vec operator- (vec a, vec b) noexcept { return {a.v - b.v}; }
+	friend vec operator* (vec a, vec b) noexcept { return {a.v * b.v}; }
+	friend vec operator/ (vec a, vec b) noexcept { return {a.v / b.v}; }
+	friend vec min (vec a, vec b) noexcept { return {std::min (a.v, b.v)}; }
+	friend vec max (vec a, vec b) noexcept { return {std::max (a.v, b.v)}; }
+	/** round to the nearest integer */
+	friend vec nearest (vec a) noexcept { return {simd::nearest (a.v)}; }
+	/** round towards zero, a must be in the range of int32_t */
+	friend vec truncate (vec a) noexcept { return {simd::truncate (a.v)}; }
+	/** convert all lanes to int32_t (rounding towards zero) and store them unaligned */
+	void store_int32 (int32_t* p) const noexcept { *p = static_cast<int32_t> (v); }
+	/** returns the unbiased binary exponent of positive normal numbers */
+	friend vec exponent (vec a) noexcept { return {simd::exponent (a.v)}; }
+	/** returns the mantissa of positive normal numbers in the range [1..2) */
+	friend vec mantissa (vec a) noexcept { return {simd::mantissa (a.v)}; }
+	/** returns 2^n for integral n in the exponent range of normal numbers */
+	friend vec pow2 (vec n) noexcept { return {simd::pow2 (n.v)}; }
+
+	/** interleave a and b into {a0, b0, a1, b1, ...} stored in lo and hi */
+	static void zip (vec a, vec b, vec& lo, vec& hi) noexcept
+	{
+		lo = a;
+		hi = b;
+	}
+	/** the inverse of zip */
+	static void unzip (vec lo, vec hi, vec& a, vec& b) noexcept
+	{
+		a = lo;
+		b = hi;
+	}
+};
+
+#if defined(VST3UTILS_SIMD_AVX2)
+//------------------------------------------------------------------------
+template<>
+struct vec<float>
+{
+	using value_type = float;
+	static constexpr size_t size = 8u;
+	static constexpr size_t alignment = 32u;
+
+	__m256 v;
+
+	static vec load (const float* p) noexcept { return {_mm256_load_ps (p)}; }
+	static vec loadu (const float* p) noexcept { return {_mm256_loadu_ps (p)}; }
+	void store (float* p) const noexcept { _mm256_store_ps (p, v); }
+	void storeu (float* p) const noexcept { _mm256_storeu_ps (p, v); }
+	static vec set1 (float value) noexcept { return {_mm256_set1_ps (value)}; }
+	static vec zero () noexcept { return {_mm256_setzero_ps ()}; }
+	static vec ramp (float start, float step) noexcept
+	{
+		return {_mm256_add_ps (_mm256_set1_ps (start),
+							   _mm256_mul_ps (_mm256_set1_ps (step),
+											  _mm256_setr_ps (0, 1, 2, 3, 4, 5, 6, 7)))};
+	}
+
+	friend vec operator+ (vec a, vec b) noexcept { return {_mm256_add_ps (a.v, b.v)}; }
+	friend vec operator- (vec a, vec b) noexcept { return {_mm256_sub_ps (a.v, b.v)}; }
+	friend vec operator* (vec a, vec b) noexcept { return {_mm256_mul_ps (a.v, b.v)}; }
+	friend vec min (vec a, vec b) noexcept { return {_mm256_min_ps (a.v, b.v)}; }
+	friend vec max (vec a, vec b) noexcept { return {_mm256_max_ps (a.v, b.v)}; }
+	friend vec operator/ (vec a, vec b) noexcept { return {_mm256_div_ps (a.v, b.v)}; }
+	friend vec nearest (vec a) noexcept
+	{
+		return {_mm256_round_ps (a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+	}
+	friend vec truncate (vec a) noexcept
+	{
+		return {_mm256_round_ps (a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)};
+	}
+	void store_int32 (int32_t* p) const noexcept
+	{
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (p), _mm256_cvttps_epi32 (v));
+	}
+	friend vec exponent (vec a) noexcept
+	{
+		auto bits = _mm256_and_si256 (_mm256_srli_epi32 (_mm256_castps_si256 (a.v), 23),
+									  _mm256_set1_epi32 (0xff));
+		return {_mm256_cvtepi32_ps (_mm256_sub_epi32 (bits, _mm256_set1_epi32 (127)))};
+	}
+	friend vec mantissa (vec a) noexcept
+	{
+		auto bits = _mm256_and_si256 (_mm256_castps_si256 (a.v), _mm256_set1_epi32 (0x007fffff));
+		return {_mm256_castsi256_ps (_mm256_or_si256 (bits, _mm256_set1_epi32 (0x3f800000)))};
+	}
+	friend vec pow2 (vec n) noexcept
+	{
+		auto bits = _mm256_add_epi32 (_mm256_cvtps_epi32 (n.v), _mm256_set1_epi32 (127));
+		return {_mm256_castsi256_ps (_mm256_slli_epi32 (bits, 23))};
+	}
+
+	static void zip (vec a, vec b, vec& lo, vec& hi) noexcept
+	{
+		auto l = _mm256_unpacklo_ps (a.v, b.v);
+		auto h = _mm256_unpackhi_ps (a.v, b.v);
+		lo.v = _mm256_permute2f128_ps (l, h, 0x20);
+		hi.v = _mm256_permute2f128_ps (l, h, 0x31);
+	}
+	static void unzip (vec lo, vec hi, vec& a, vec& b) noexcept
+	{
+		auto even = _mm256_shuffle_ps (lo.v, hi.v, _MM_SHUFFLE (2, 0, 2, 0));
+		auto odd = _mm256_shuffle_ps (lo.v, hi.v, _MM_SHUFFLE (3, 1, 3, 1));
+		a.v = _mm256_castpd_ps (
+			_mm256_permute4x64_pd (_mm256_castps_pd (even), _MM_SHUFFLE (3, 1, 2, 0)));
+		b.v = _mm256_castpd_ps (
+			_mm256_permute4x64_pd (_mm256_castps_pd (odd), _MM_SHUFFLE (3, 1, 2, 0)));
+	}
+};
+
+//------------------------------------------------------------------------
+template<>
+struct vec<double>
+{
+	using value_type = double;
+	static constexpr size_t size = 4u;
+	static constexpr size_t alignment = 32u;
+
+	__m256d v;
+
+	static vec load (const double* p) noexcept { return {_mm256_load_pd (p)}; }
+	static vec loadu (const double* p) noexcept { return {_mm256_loadu_pd (p)}; }
+	void store (double* p) const noexcept { _mm256_store_pd (p, v); }
+	void storeu (double* p) const noexcept { _mm256_storeu_pd (p, v); }
+	static vec set1 (double value) noexcept { return {_mm256_set1_pd (value)}; }
+	static vec zero () noexcept { return {_mm256_setzero_pd ()}; }
+	static vec ramp (double start, double step) noexcept
+	{
+		return {_mm256_add_pd (_mm256_set1_pd (start),
+							   _mm256_mul_pd (_mm256_set1_pd (step), _mm256_setr_pd (0, 1, 2, 3)))};
+	}
+
+	friend vec operator+ (vec a, vec b) noexcept { return {_mm256_add_pd (a.v, b.v)}; }
+	friend vec operator- (vec a, vec b) noexcept { return {_mm256_sub_pd (a.v, b.v)}; }
+	friend vec operator* (vec a, vec b) noexcept { return {_mm256_mul_pd (a.v, b.v)}; }
+	friend vec min (vec a, vec b) noexcept { return {_mm256_min_pd (a.v, b.v)}; }
+	friend vec max (vec a, vec b) noexcept { return {_mm256_max_pd (a.v, b.v)}; }
+	friend vec operator/ (vec a, vec b) noexcept { return {_mm256_div_pd (a.v, b.v)}; }
+	friend vec nearest (vec a) noexcept
+	{
+		return {_mm256_round_pd (a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+	}
+	friend vec truncate (vec a) noexcept
+	{
+		return {_mm256_round_pd (a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)};
+	}
+	void store_int32 (int32_t* p) const noexcept
+	{
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (p), _mm256_cvttpd_epi32 (v));
+	}
+	// 2^52 is used to convert between the integer in the low bits and double
+	friend vec exponent (vec a) noexcept
+	{
+		auto magic = _mm256_set1_pd (4503599627370496.);
+		auto bits = _mm256_and_si256 (_mm256_srli_epi64 (_mm256_castpd_si256 (a.v), 52),
+									  _mm256_set1_epi64x (0x7ff));
+		auto e = _mm256_castsi256_pd (_mm256_or_si256 (bits, _mm256_castpd_si256 (magic)));
+		return {_mm256_sub_pd (_mm256_sub_pd (e, magic), _mm256_set1_pd (1023.))};
+	}
+	friend vec mantissa (vec a) noexcept
+	{
+		auto bits = _mm256_and_si256 (_mm256_castpd_si256 (a.v),
+									  _mm256_set1_epi64x (0x000fffffffffffffll));
+		return {_mm256_castsi256_pd (
+			_mm256_or_si256 (bits, _mm256_set1_epi64x (0x3ff0000000000000ll)))};
+	}
+	friend vec pow2 (vec n) noexcept
+	{
+		auto magic = _mm256_set1_pd (4503599627370496.);
+		auto biased = _mm256_add_pd (_mm256_add_pd (n.v, _mm256_set1_pd (1023.)), magic);
+		auto bits = _mm256_castpd_si256 (biased);
+		return {_mm256_castsi256_pd (_mm256_slli_epi64 (bits, 52))};
+	}
+
+	static void zip (vec a, vec b, vec& lo, vec& hi) noexcept
+	{
+		auto l = _mm256_unpacklo_pd (a.v, b.v);
+		auto h = _mm256_unpackhi_pd (a.v, b.v);
+		lo.v = _mm256_permute2f128_pd (l, h, 0x20);
+		hi.v = _mm256_permute2f128_pd (l, h, 0x31);
+	}
+	static void unzip (vec lo, vec hi, vec& a, vec& b) noexcept
+	{
+		a.v = _mm256_permute4x64_pd (_mm256_unpacklo_pd (lo.v, hi.v), _MM_SHUFFLE (3, 1, 2, 0));
+		b.v = _mm256_permute4x64_pd (_mm256_unpackhi_pd (lo.v, hi.v), _MM_SHUFFLE (3, 1, 2, 0));
+	}
+};
+
+#elif defined(VST3UTILS_SIMD_SSE2)
+//------------------------------------------------------------------------
+template<>
+struct vec<float>
+{
+	using value_type = float;
+	static constexpr size_t size = 4u;
+	static constexpr size_t alignment = 16u;
+
+	__m128 v;
+
+	static vec load (const float* p) noexcept { return {_mm_load_ps (p)}; }
+	static vec loadu (const float* p) noexcept { return {_mm_loadu_ps (p)}; }
+	void store (float* p) const noexcept { _mm_store_ps (p, v); }
+	void storeu (float* p) const noexcept { _mm_storeu_ps (p, v); }
+	static vec set1 (float value) noexcept { return {_mm_set1_ps (value)}; }
+	static vec zero () noexcept { return {_mm_setzero_ps ()}; }
+	static vec ramp (float start, float step) noexcept
+	{
+		return {_mm_add_ps (_mm_set1_ps (start),
+							_mm_mul_ps (_mm_set1_ps (step), _mm_setr_ps (0, 1, 2, 3)))};
+	}
+
+	friend vec operator+ (vec a, vec b) noexcept { return {_mm_add_ps (a.v, b.v)}; }
+	friend vec operator- (vec a, vec b) noexcept { return {_mm_sub_ps (a.v, b.v)}; }
+	friend vec operator* (vec a, vec b) noexcept { return {_mm_mul_ps (a.v, b.v)}; }
+	friend vec min (vec a, vec b) noexcept { return {_mm_min_ps (a.v, b.v)}; }
+	friend vec max (vec a, vec b) noexcept { return {_mm_max_ps (a.v, b.v)}; }
+	friend vec operator/ (vec a, vec b) noexcept { return {_mm_div_ps (a.v, b.v)}; }
+	friend vec nearest (vec a) noexcept { return {_mm_cvtepi32_ps (_mm_cvtps_epi32 (a.v))}; }
+	friend vec truncate (vec a) noexcept { return {_mm_cvtepi32_ps (_mm_cvttps_epi32 (a.v))}; }
+	void store_int32 (int32_t* p) const noexcept
+	{
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (p), _mm_cvttps_epi32 (v));
+	}
+	friend vec exponent (vec a) noexcept
+	{
+		auto bits =
+			_mm_and_si128 (_mm_srli_epi32 (_mm_castps_si128 (a.v), 23), _mm_set1_epi32 (0xff));
+		return {_mm_cvtepi32_ps (_mm_sub_epi32 (bits, _mm_set1_epi32 (127)))};
+	}
+	friend vec mantissa (vec a) noexcept
+	{
+		auto bits = _mm_and_si128 (_mm_castps_si128 (a.v), _mm_set1_epi32 (0x007fffff));
+		return {_mm_castsi128_ps (_mm_or_si128 (bits, _mm_set1_epi32 (0x3f800000)))};
+	}
+	friend vec pow2 (vec n) noexcept
+	{
+		auto bits = _mm_add_epi32 (_mm_cvtps_epi32 (n.v), _mm_set1_epi32 (127));
+		return {_mm_castsi128_ps (_mm_slli_epi32 (bits, 23))};
+	}
+
+	static void zip (vec a, vec b, vec& lo, vec& hi) noexcept
+	{
+		lo.v = _mm_unpacklo_ps (a.v, b.v);
+		hi.v = _mm_unpackhi_ps (a.v, b.v);
+	}
+	static void unzip (vec lo, vec hi, vec& a, vec& b) noexcept
+	{
+		a.v = _mm_shuffle_ps (lo.v, hi.v, _MM_SHUFFLE (2, 0, 2, 0));
+		b.v = _mm_shuffle_ps (lo.v, hi.v, _MM_SHUFFLE (3, 1, 3, 1));
+	}
+};
+
+//------------------------------------------------------------------------
+template<>
+struct vec<double>
+{
+	using value_type = double;
+	static constexpr size_t size = 2u;
+	static constexpr size_t alignment = 16u;
+
+	__m128d v;
+
+	static vec load (const double* p) noexcept { return {_mm_load_pd (p)}; }
+	static vec loadu (const double* p) noexcept { return {_mm_loadu_pd (p)}; }
+	void store (double* p) const noexcept { _mm_store_pd (p, v); }
+	void storeu (double* p) const noexcept { _mm_storeu_pd (p, v); }
+	static vec set1 (double value) noexcept { return {_mm_set1_pd (value)}; }
+	static vec zero () noexcept { return {_mm_setzero_pd ()}; }
+	static vec ramp (double start, double step) noexcept
+	{
+		return {_mm_add_pd (_mm_set1_pd (start), _mm_mul_pd (_mm_set1_pd (step), _mm_setr_pd (0, 1)))};
+	}
+
+	friend vec operator+ (vec a, vec b) noexcept { return {_mm_add_pd (a.v, b.v)}; }
+	friend vec operator- (vec a, vec b) noexcept { return {_mm_sub_pd (a.v, b.v)}; }
+	friend vec operator* (vec a, vec b) noexcept { return {_mm_mul_pd (a.v, b.v)}; }
+	friend vec min (vec a, vec b) noexcept { return {_mm_min_pd (a.v, b.v)}; }
+	friend vec max (vec a, vec b) noexcept { return {_mm_max_pd (a.v, b.v)}; }
+	friend vec operator/ (vec a, vec b) noexcept { return {_mm_div_pd (a.v, b.v)}; }
+	friend vec nearest (vec a) noexcept { return {_mm_cvtepi32_pd (_mm_cvtpd_epi32 (a.v))}; }
+	friend vec truncate (vec a) noexcept { return {_mm_cvtepi32_pd (_mm_cvttpd_epi32 (a.v))}; }
+	void store_int32 (int32_t* p) const noexcept
+	{
+		_mm_storel_epi64 (reinterpret_cast<__m128i*> (p), _mm_cvttpd_epi32 (v));
+	}
+	// 2^52 is used to convert between the integer in the low bits and double
+	friend vec exponent (vec a) noexcept
+	{
+		auto magic = _mm_set1_pd (4503599627370496.);
+		auto bits =
+			_mm_and_si128 (_mm_srli_epi64 (_mm_castpd_si128 (a.v), 52), _mm_set1_epi64x (0x7ff));
+		auto e = _mm_castsi128_pd (_mm_or_si128 (bits, _mm_castpd_si128 (magic)));
+		return {_mm_sub_pd (_mm_sub_pd (e, magic), _mm_set1_pd (1023.))};
+	}
+	friend vec mantissa (vec a) noexcept
+	{
+		auto bits = _mm_and_si128 (_mm_castpd_si128 (a.v), _mm_set1_epi64x (0x000fffffffffffffll));
+		return {_mm_castsi128_pd (_mm_or_si128 (bits, _mm_set1_epi64x (0x3ff0000000000000ll)))};
+	}
+	friend vec pow2 (vec n) noexcept
+	{
+		auto magic = _mm_set1_pd (4503599627370496.);
+		auto bits = _mm_castpd_si128 (_mm_add_pd (_mm_add_pd (n.v, _mm_set1_pd (1023.)), magic));
+		return {_mm_castsi128_pd (_mm_slli_epi64 (bits, 52))};
+	}
+
+	static void zip (vec a, vec b, vec& lo, vec& hi) noexcept
+	{
+		lo.v = _mm_unpacklo_pd (a.v, b.v);
+		hi.v = _mm_unpackhi_pd (a.v, b.v);
+	}
+	static void unzip (vec lo, vec hi, vec& a, vec& b) noexcept
+	{
+		a.v = _mm_unpacklo_pd (lo.v, hi.v);
+		b.v = _mm_unpackhi_pd (lo.v, hi.v);
+	}
+};
+
+#endif
+
+//------------------------------------------------------------------------
+/** the element type of a vec or the type itself for float and double */
+template<typename V>
+struct value_type
+{
+	using type = typename V::value_type;
+};
+template<>
+struct value_type<float>
+{
+	using type = float;
+};
+template<>
+struct value_type<double>
+{
+	using type = double;
+};
+template<typename V>
+using value_type_t = typename value_type<V>::type;
+
+//------------------------------------------------------------------------
+/** returns value for float and double or a vector with all lanes set to value */
+template<typename V>
+inline V splat (value_type_t<V> value) noexcept
+{
+	if constexpr (std::is_floating_point_v<V>)
+		return value;
+	else
+		return V::set1 (value);
+}
+
+//------------------------------------------------------------------------
+/** clamp x to the range [lo..hi] for float, double and vec */
+template<typename V>
+inline V clamp (V x, V lo, V hi) noexcept
+{
+	return min (max (x, lo), hi);
+}
+
+//------------------------------------------------------------------------
+/** returns true if the pointer is aligned to the alignment of the native vector */
+template<typename T>
+inline bool is_aligned (const T* ptr) noexcept
+{
+	return (reinterpret_cast<uintptr_t> (ptr) & (vec<T>::alignment - 1u)) == 0u;
+}
+
+//------------------------------------------------------------------------
+} // simd
+
+namespace detail {
+
+//------------------------------------------------------------------------
+/** returns the index of the lowest set bit, v must not be zero */
+inline uint32_t count_trailing_zeros (uint64_t v) noexcept
+{
+	assert (v != 0u);
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64 (&index, v);
+	return static_cast<uint32_t> (index);
+#elif defined(__GNUC__) || defined(__clang__)
+	return static_cast<uint32_t> (__builtin_ctzll (v));
+#else
+	uint32_t index = 0u;
+	while ((v & 1u) == 0u)
+	{
+		v >>= 1;
+		++index;
+	}
+	return index;
+#endif
+}
+
+//------------------------------------------------------------------------
+} // detail
+} // vst3utils
@@ -8,12 +8,74 @@
 
 #pragma once
 
+#include "vst3utils/simd.h"
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 //------------------------------------------------------------------------
 namespace vst3utils {
 
+namespace detail {
+
+//------------------------------------------------------------------------
+/** render num_samples steps of a one-pole smoother into io (or multiply io with them)
+ *
+ *	the smoothed value after k steps is value + (smoothed - value) * (1 - alpha)^k, which is
+ *	computed with one simd lane per sample. smoothed is updated to the last rendered value.
+ */
+template<bool multiply, typename T>
+inline void render_one_pole (T* io, size_t num_samples, T value, T& smoothed, T alpha) noexcept
+{
+	using vec = simd::vec<T>;
+	auto render = [io] (size_t index, auto gain) {
+		if constexpr (multiply)
+			(vec::loadu (io + index) * gain).storeu (io + index);
+		else
+			gain.storeu (io + index);
+	};
+
+	const auto vec_end = num_samples - num_samples % vec::size;
+	size_t i = 0u;
+	if (smoothed == value)
+	{
+		auto gain = vec::set1 (value);
+		for (; i < vec_end; i += vec::size)
+			render (i, gain);
+		for (; i < num_samples; ++i)
+			io[i] = multiply ? io[i] * value : value;
+		return;
+	}
+
+	const auto factor = static_cast<T> (1) - alpha;
+	T lane_factors[vec::size];
+	T factor_pow = static_cast<T> (1);
+	for (auto& lane : lane_factors)
+		lane = (factor_pow *= factor);
+	auto distance = smoothed - value;
+	auto lane_distance = vec::loadu (lane_factors) * vec::set1 (distance);
+	const auto lane_step = vec::set1 (factor_pow);
+	const auto target = vec::set1 (value);
+	for (; i < vec_end; i += vec::size)
+	{
+		render (i, target + lane_distance);
+		lane_distance = lane_distance * lane_step;
+		distance *= factor_pow;
+	}
+	for (; i < num_samples; ++i)
+	{
+		distance *= factor;
+		io[i] = multiply ? io[i] * (value + distance) : value + distance;
+	}
+	smoothed = value + distance;
+}
+
+//------------------------------------------------------------------------
+} // detail
+
 //------------------------------------------------------------------------
 /** smooth value
 
@@ -40,6 +102,24 @@ struct smooth_value
 		return smoothed_value;
 	}
 
+	/** smooth the parameter further for num_samples samples and write the smoothed values to out
+	 *
+	 *	the result is equivalent to calling process () num_samples times, but the trajectory is
+	 *	computed in closed form so that it can be vectorized. once the smoothed value has reached
+	 *	the value the block is just filled with the value.
+	 */
+	inline void process_block (T* out, size_t num_samples) noexcept
+	{
+		render_block<false> (out, num_samples);
+	}
+
+	/** smooth the parameter further for num_samples samples and multiply io with the smoothed
+	 * values */
+	inline void apply_gain_block (T* io, size_t num_samples) noexcept
+	{
+		render_block<true> (io, num_samples);
+	}
+
 	/** set the value to be reached */
 	inline void set (T v) noexcept { value = v; }
 	/** get the value to be reached */
@@ -77,10 +157,375 @@ struct smooth_value
 	inline void set_flushed (T v) noexcept { smoothed_value = value = v; }
 
 private:
+	template<bool multiply>
+	inline void render_block (T* io, size_t num_samples) noexcept
+	{
+		detail::render_one_pole<multiply> (io, num_samples, value, smoothed_value, alpha);
+	}
+
 	T alpha {0.1};
 	T value {0.};
 	T smoothed_value {0.};
 };
 
+//------------------------------------------------------------------------
+/** time constant based smooth value
+
+a smooth value configured with a smoothing time in milliseconds and the sample rate instead of a
+raw alpha, so the smoothing time does not depend on the sample rate.
+
+when the smoothed value is within epsilon of the value it is snapped to the value and the smooth
+value is settled. while settled no smoothing is done at all, and is_settled () can be used to skip
+coefficient recomputation and other per sample work in the DSP.
+
+ */
+template<typename T>
+struct timed_smooth_value
+{
+	static_assert (std::is_floating_point_v<T>, "Must be a floating point type");
+
+	timed_smooth_value (T initial_value = {}, T time_ms = static_cast<T> (10.),
+						double sample_rate = 44100., T epsilon = static_cast<T> (1e-5))
+	: smoother (initial_value), epsilon (epsilon)
+	{
+		set_time (time_ms, sample_rate);
+	}
+
+	/** returns the alpha of smooth_value for a time constant in milliseconds */
+	static T alpha_for_time (T time_ms, double sample_rate) noexcept
+	{
+		auto num_samples = static_cast<double> (time_ms) * 0.001 * sample_rate;
+		if (num_samples <= 1.)
+			return static_cast<T> (1.);
+		return static_cast<T> (1. - std::exp (-1. / num_samples));
+	}
+
+	/** set the smoothing time constant
+	 *
+	 *	the coefficient is only recomputed if the time or the sample rate has changed
+	 */
+	inline void set_time (T time_ms, double sample_rate) noexcept
+	{
+		if (time_ms == time && sample_rate == rate)
+			return;
+		time = time_ms;
+		rate = sample_rate;
+		smoother.set_alpha (alpha_for_time (time_ms, sample_rate));
+	}
+
+	/** set the maximum distance where the smoothed value is considered to be settled */
+	inline void set_epsilon (T v) noexcept { epsilon = v; }
+
+	/** smooth the parameter further and return the smoothed value */
+	inline T process () noexcept
+	{
+		if (settled)
+			return smoother.get ();
+		auto previous = *smoother;
+		auto smoothed = smoother.process ();
+		// with small alphas float smoothers may stop moving before reaching epsilon
+		if (smoothed == previous)
+			flush ();
+		else
+			check_settled (smoothed);
+		return *smoother;
+	}
+
+	/** smooth the parameter further for num_samples and write the smoothed values to out */
+	inline void process_block (T* out, size_t num_samples) noexcept
+	{
+		smoother.process_block (out, num_samples);
+		if (!settled)
+			check_settled (*smoother);
+	}
+
+	/** smooth the parameter further for num_samples and multiply io with the smoothed values */
+	inline void apply_gain_block (T* io, size_t num_samples) noexcept
+	{
+		smoother.apply_gain_block (io, num_samples);
+		if (!settled)
+			check_settled (*smoother);
+	}
+
+	/** returns true if the smoothed value has reached the value */
+	inline bool is_settled () const noexcept { return settled; }
+
+	/** set the value to be reached */
+	inline void set (T v) noexcept
+	{
+		if (v == smoother.get ())
+			return;
+		smoother.set (v);
+		settled = false;
+	}
+	/** get the value to be reached */
+	inline T get () const noexcept { return smoother.get (); }
+
+	/** get the smoothed value */
+	inline T operator* () noexcept { return *smoother; }
+	/** get the smoothed value */
+	inline operator T () noexcept { return *smoother; }
+
+	/** set the value to be reached */
+	inline timed_smooth_value& operator= (T v) noexcept
+	{
+		set (v);
+		return *this;
+	}
+
+	/** set the smoothed value to the actual value */
+	inline void flush () noexcept
+	{
+		smoother.flush ();
+		settled = true;
+	}
+
+	/** set the smoothed value and the actual value */
+	inline void set_flushed (T v) noexcept
+	{
+		smoother.set_flushed (v);
+		settled = true;
+	}
+
+private:
+	inline void check_settled (T smoothed) noexcept
+	{
+		auto distance = smoothed - smoother.get ();
+		if (distance <= epsilon && distance >= -epsilon)
+			flush ();
+	}
+
+	smooth_value<T> smoother;
+	T epsilon;
+	T time {-1};
+	double rate {0.};
+	bool settled {true};
+};
+
+//------------------------------------------------------------------------
+/** a bank of N smooth values stored as structure of arrays
+
+the values, smoothed values and alphas are stored in contiguous aligned arrays, so that process ()
+advances all smoothers with simd across the smoothers.
+
+smoothers which are within epsilon of their value are settled and snapped to their value. settled
+smoothers are tracked in a bit mask and groups of settled smoothers are skipped, so a block where
+nothing moves costs almost nothing.
+
+Example:
+
+	smooth_value_bank<float, num_params> smoothers;
+
+	// in setupProcessing
+	for (auto i = 0u; i < smoothers.size (); ++i)
+		smoothers.set_time (i, 20.f, setup.sampleRate);
+
+	// in process
+	if (!smoothers.all_settled ())
+	{
+		for (auto s = 0; s < data.numSamples; ++s)
+		{
+			smoothers.process ();
+			// ...
+		}
+	}
+
+ */
+template<typename T, size_t N>
+struct smooth_value_bank
+{
+	static_assert (std::is_floating_point_v<T>, "Must be a floating point type");
+
+	smooth_value_bank (T alpha = static_cast<T> (0.1), T epsilon = static_cast<T> (1e-5))
+	: epsilon (epsilon)
+	{
+		alphas.fill (alpha);
+		values.fill (static_cast<T> (0));
+		smoothed.fill (static_cast<T> (0));
+		active.fill (0u);
+	}
+
+	/** returns the number of smoothers */
+	static constexpr size_t size () noexcept { return N; }
+
+	/** set the value to be reached */
+	inline void set (size_t index, T v) noexcept
+	{
+		assert (index < N);
+		values[index] = v;
+		if (v != smoothed[index])
+			active[index / 64u] |= bit (index);
+	}
+	/** get the value to be reached */
+	inline T get (size_t index) const noexcept
+	{
+		assert (index < N);
+		return values[index];
+	}
+	/** get the smoothed value */
+	inline T smoothed_value (size_t index) const noexcept
+	{
+		assert (index < N);
+		return smoothed[index];
+	}
+
+	/** set the smoothing factor [0..1] of one smoother */
+	inline void set_alpha (size_t index, T alpha) noexcept
+	{
+		assert (index < N);
+		assert (alpha >= static_cast<T> (0) && alpha <= static_cast<T> (1));
+		alphas[index] = alpha;
+	}
+	/** set the smoothing time constant of one smoother */
+	inline void set_time (size_t index, T time_ms, double sample_rate) noexcept
+	{
+		set_alpha (index, timed_smooth_value<T>::alpha_for_time (time_ms, sample_rate));
+	}
+	/** set the maximum distance where a smoother is considered to be settled */
+	inline void set_epsilon (T v) noexcept { epsilon = v; }
+
+	/** set the smoothed value to the value */
+	inline void flush (size_t index) noexcept
+	{
+		assert (index < N);
+		smoothed[index] = values[index];
+		active[index / 64u] &= ~bit (index);
+	}
+	/** set the smoothed value and the value */
+	inline void set_flushed (size_t index, T v) noexcept
+	{
+		assert (index < N);
+		values[index] = v;
+		flush (index);
+	}
+	/** set all smoothed values to their value */
+	inline void flush_all () noexcept
+	{
+		smoothed = values;
+		active.fill (0u);
+	}
+
+	/** returns true if the smoother has reached its value */
+	inline bool is_settled (size_t index) const noexcept
+	{
+		assert (index < N);
+		return (active[index / 64u] & bit (index)) == 0u;
+	}
+	/** returns true if all smoothers have reached their value */
+	inline bool all_settled () const noexcept
+	{
+		for (auto word : active)
+		{
+			if (word)
+				return false;
+		}
+		return true;
+	}
+
+	/** advance all smoothers by one sample */
+	inline void process () noexcept
+	{
+		constexpr uint64_t group_mask = (uint64_t {1} << lanes_per_vec) - 1u;
+		const auto one = vec::set1 (static_cast<T> (1));
+		for (size_t lane = 0u; lane < num_lanes; lane += lanes_per_vec)
+		{
+			auto group = (active[lane / 64u] >> (lane % 64u)) & group_mask;
+			if (group == 0u)
+				continue;
+			T previous[lanes_per_vec];
+			auto a = vec::load (alphas.data () + lane);
+			auto s = vec::load (smoothed.data () + lane);
+			s.storeu (previous);
+			s = a * vec::load (values.data () + lane) + (one - a) * s;
+			s.store (smoothed.data () + lane);
+			for (size_t offset = 0u; offset < lanes_per_vec; ++offset)
+			{
+				auto index = lane + offset;
+				if (((group >> offset) & 1u) == 0u)
+				{
+					// keep settled smoothers exactly on their value
+					smoothed[index] = previous[offset];
+					continue;
+				}
+				// with small alphas float smoothers may stop moving before reaching epsilon
+				if (smoothed[index] == previous[offset])
+					flush (index);
+				else
+					check_settled (index);
+			}
+		}
+	}
+
+	/** advance all smoothers by num_samples samples in closed form without per sample work */
+	inline void advance (size_t num_samples) noexcept
+	{
+		for_each_active ([&] (size_t index) {
+			auto factor = std::pow (static_cast<T> (1) - alphas[index], static_cast<T> (num_samples));
+			smoothed[index] = values[index] + (smoothed[index] - values[index]) * factor;
+			check_settled (index);
+		});
+	}
+
+	/** advance one smoother by num_samples samples and write the smoothed values to out
+	 *
+	 *	do not call advance () for the same block, as this also advances the smoother
+	 */
+	inline void process_block (size_t index, T* out, size_t num_samples) noexcept
+	{
+		assert (index < N);
+		detail::render_one_pole<false> (out, num_samples, values[index], smoothed[index],
+										alphas[index]);
+		check_settled (index);
+	}
+
+	/** advance one smoother by num_samples samples and multiply io with the smoothed values
+	 *
+	 *	do not call advance () for the same block, as this also advances the smoother
+	 */
+	inline void apply_gain_block (size_t index, T* io, size_t num_samples) noexcept
+	{
+		assert (index < N);
+		detail::render_one_pole<true> (io, num_samples, values[index], smoothed[index],
+									   alphas[index]);
+		check_settled (index);
+	}
+
+private:
+	using vec = simd::vec<T>;
+	static constexpr size_t lanes_per_vec = vec::size;
+	static constexpr size_t num_lanes = ((N + lanes_per_vec - 1u) / lanes_per_vec) * lanes_per_vec;
+	static constexpr size_t num_mask_words = (num_lanes + 63u) / 64u;
+	static_assert (64u % lanes_per_vec == 0u);
+
+	static constexpr uint64_t bit (size_t index) noexcept { return uint64_t {1} << (index % 64u); }
+
+	inline void check_settled (size_t index) noexcept
+	{
+		auto distance = smoothed[index] - values[index];
+		if (distance <= epsilon && distance >= -epsilon)
+			flush (index);
+	}
+
+	template<typename Proc>
+	inline void for_each_active (Proc proc) noexcept
+	{
+		for (size_t word_index = 0u; word_index < num_mask_words; ++word_index)
+		{
+			auto word = active[word_index];
+			while (word)
+			{
+				proc (word_index * 64u + detail::count_trailing_zeros (word));
+				word &= word - 1u;
+			}
+		}
+	}
+
+	alignas (vec::alignment) std::array<T, num_lanes> values;
+	alignas (vec::alignment) std::array<T, num_lanes> smoothed;
+	alignas (vec::alignment) std::array<T, num_lanes> alphas;
+	std::array<uint64_t, num_mask_words> active;
+	T epsilon;
+};
+
 //------------------------------------------------------------------------
 } // vst3utils
@@ -45,6 +45,25 @@ inline std::string copy_utf16_to_ascii (std::u16string_view str)
 	return copy_utf16_to_ascii<0> (str);
 }
 
+//------------------------------------------------------------------------
+/** copy UTF-16 string to an ASCII buffer without allocating
+ *
+ *  All non-ASCII characters are removed during this conversion. The result is not zero
+ *	terminated and truncated if the buffer is too small.
+ *
+ *	@return the number of characters written
+ */
+inline size_t copy_utf16_to_ascii (std::u16string_view str, char* start, char* end) noexcept
+{
+	auto out = start;
+	for (auto it = str.begin (); it != str.end () && out != end; ++it)
+	{
+		if (*it <= 127)
+			*out++ = static_cast<char> (*it);
+	}
+	return static_cast<size_t> (out - start);
+}
+
 //------------------------------------------------------------------------
 /** create an UTF-16 string from an ASCII string */
 inline std::u16string create_utf16_from_ascii (std::string_view ascii)
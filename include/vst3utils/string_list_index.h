@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** sorted index of a list of UTF-16 strings for O(log n) lookup of a string
+
+the index only stores the permutation which sorts the strings, the strings themselves are not
+copied and must outlive the index.
+
+use get to share one index between all users of the same string list, e.g. all list parameters
+using the same param::step_count::string_list. It is built on first use and requires a string list
+with static storage duration.
+
+ */
+class string_list_index
+{
+public:
+	string_list_index (const char16_t* const* strings, size_t num_strings)
+	: strings (strings), sorted (num_strings)
+	{
+		std::iota (sorted.begin (), sorted.end (), 0u);
+		std::stable_sort (sorted.begin (), sorted.end (),
+						  [&] (auto lhs, auto rhs) { return view (lhs) < view (rhs); });
+	}
+
+	/** returns the index of the first occurrence of str in the list or -1 if not found */
+	int32_t find (std::u16string_view str) const noexcept
+	{
+		auto it = std::lower_bound (sorted.begin (), sorted.end (), str,
+									[&] (auto index, auto s) { return view (index) < s; });
+		if (it == sorted.end () || view (*it) != str)
+			return -1;
+		return static_cast<int32_t> (*it);
+	}
+
+	/** returns the number of strings in the list */
+	size_t size () const noexcept { return sorted.size (); }
+
+	/** returns the shared index of the first num_strings strings of the list
+	 *
+	 *	the index is built on the first call for the list and the number of strings and lives
+	 *	until the end of the program. The list and its strings must have static storage duration
+	 *	and must not change, a list at the address of a freed list gets the index of the freed
+	 *	list.
+	 */
+	static const string_list_index& get (const char16_t* const* strings, size_t num_strings)
+	{
+		static std::mutex mutex;
+		static std::map<std::pair<const char16_t* const*, size_t>,
+						std::unique_ptr<string_list_index>>
+			indices;
+		std::lock_guard<std::mutex> guard (mutex);
+		auto& index = indices[{strings, num_strings}];
+		if (!index)
+			index = std::make_unique<string_list_index> (strings, num_strings);
+		return *index;
+	}
+
+private:
+	std::u16string_view view (uint32_t index) const noexcept { return strings[index]; }
+
+	const char16_t* const* strings;
+	std::vector<uint32_t> sorted;
+};
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#pragma once
+
+#include "vst3utils/event_iterator.h"
+#include "vst3utils/parameter_changes_snapshot.h"
+#include <algorithm>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+/** splits a process block into sub-blocks at the parameter changes and events
+
+the points of all parameter queues and all events are merged into one timeline sorted by sample
+offset. A new sub-block starts at every sample offset of the timeline, the callback is called for
+every sub-block with the parameter changes and events to apply at its start.
+
+a sub-block is at least min_sub_block_size samples long (except the last one of a block). Changes
+and events within the first min_sub_block_size samples of a sub-block are applied at its start,
+so dense automation does not split the block into tiny pieces. Changes keep their original sample
+offset so the callback can still see how early they are applied.
+
+if the block has no samples (a parameter flush) the callback is called once with all changes and
+events if there are any.
+
+the storage is allocated by setup, process never allocates. Points and events which do not fit
+are dropped.
+
+Example:
+
+	sub_block_scheduler scheduler;
+
+	// in setupProcessing
+	scheduler.setup (num_parameters * 8, 512, 16);
+
+	// in process
+	scheduler.process (data.inputParameterChanges, data.inputEvents, data.numSamples,
+					   [&] (const sub_block_scheduler::sub_block& block) {
+						   for (size_t i = 0; i < block.num_changes (); ++i)
+							   apply (block.pid (i), block.value (i));
+						   for (size_t i = 0; i < block.num_events; ++i)
+							   handle (block.events[i]);
+						   render (block.start, block.num_samples);
+					   });
+
+ */
+class sub_block_scheduler
+{
+public:
+	using IParameterChanges = Steinberg::Vst::IParameterChanges;
+	using IEventList = Steinberg::Vst::IEventList;
+	using Event = Steinberg::Vst::Event;
+	using ParamID = Steinberg::Vst::ParamID;
+	using ParamValue = Steinberg::Vst::ParamValue;
+	using int32 = Steinberg::int32;
+
+	struct sub_block
+	{
+		/** the first sample of the sub-block */
+		int32 start {0};
+		/** the number of samples of the sub-block */
+		int32 num_samples {0};
+		/** the events to handle at the start of the sub-block, ordered by sample offset */
+		const Event* events {nullptr};
+		size_t num_events {0u};
+
+		/** the number of parameter changes to apply at the start of the sub-block */
+		size_t num_changes () const noexcept { return last_change - first_change; }
+		ParamID pid (size_t index) const noexcept { return changes->pid (first_change + index); }
+		ParamValue value (size_t index) const noexcept
+		{
+			return changes->value (first_change + index);
+		}
+		int32 sample_offset (size_t index) const noexcept
+		{
+			return changes->sample_offset (first_change + index);
+		}
+
+	private:
+		friend class sub_block_scheduler;
+		const parameter_changes_snapshot* changes {nullptr};
+		size_t first_change {0u};
+		size_t last_change {0u};
+	};
+
+	/** allocate the storage
+	 *
+	 *	@param max_points the maximum number of parameter points per block
+	 *	@param max_events the maximum number of events per block
+	 *	@param min_sub_block_size the minimum number of samples of a sub-block
+	 */
+	void setup (size_t max_points, size_t max_events, int32 min_sub_block_size = 1)
+	{
+		changes.setup (max_points);
+		events.resize (max_events);
+		event_order.resize (max_events);
+		scratch_events.resize (max_events);
+		set_min_sub_block_size (min_sub_block_size);
+	}
+
+	/** set the minimum number of samples of a sub-block */
+	void set_min_sub_block_size (int32 num_samples) noexcept
+	{
+		min_size = std::max (num_samples, int32 {1});
+	}
+	/** returns the minimum number of samples of a sub-block */
+	int32 min_sub_block_size () const noexcept { return min_size; }
+
+	/** split the block and call proc (const sub_block&) for every sub-block in order
+	 *
+	 *	@param parameter_changes the input parameter changes of the block, may be nullptr
+	 *	@param event_list the input events of the block, may be nullptr
+	 *	@param num_samples the number of samples of the block
+	 *	@return false if parameter points or events were dropped
+	 */
+	template<typename Proc>
+	bool process (IParameterChanges* parameter_changes, IEventList* event_list, int32 num_samples,
+				  Proc&& proc)
+	{
+		auto complete = changes.capture (parameter_changes, true);
+		complete = capture_events (event_list) && complete;
+
+		sub_block block;
+		block.changes = &changes;
+		const auto num_changes = changes.size ();
+		if (num_samples <= 0)
+		{
+			if (num_changes > 0u || num_events > 0u)
+			{
+				block.events = events.data ();
+				block.num_events = num_events;
+				block.last_change = num_changes;
+				proc (static_cast<const sub_block&> (block));
+			}
+			return complete;
+		}
+
+		size_t change_index = 0u;
+		size_t event_index = 0u;
+		int32 pos = 0;
+		while (pos < num_samples)
+		{
+			auto min_end = pos + std::min (min_size, num_samples - pos);
+			block.first_change = change_index;
+			block.events = events.data () + event_index;
+			auto first_event = event_index;
+			while (change_index < num_changes && changes.sample_offset (change_index) < min_end)
+				++change_index;
+			while (event_index < num_events && events[event_index].sampleOffset < min_end)
+				++event_index;
+			auto next = num_samples;
+			if (change_index < num_changes)
+				next = std::min (next, changes.sample_offset (change_index));
+			if (event_index < num_events)
+				next = std::min (next, events[event_index].sampleOffset);
+			if (next == num_samples)
+			{
+				// points and events after the end of the block belong to the last sub-block
+				change_index = num_changes;
+				event_index = num_events;
+			}
+			block.last_change = change_index;
+			block.num_events = event_index - first_event;
+			block.start = pos;
+			block.num_samples = next - pos;
+			proc (static_cast<const sub_block&> (block));
+			pos = next;
+		}
+		return complete;
+	}
+
+private:
+	bool capture_events (IEventList* event_list) noexcept
+	{
+		num_events = 0u;
+		if (event_list == nullptr)
+			return true;
+		bool complete = true;
+		bool sorted = true;
+		for (auto it = begin (event_list), end_it = end (event_list); it != end_it; ++it)
+		{
+			if (num_events == events.size ())
+			{
+				complete = false;
+				break;
+			}
+			if (num_events > 0u && it->sampleOffset < events[num_events - 1u].sampleOffset)
+				sorted = false;
+			events[num_events++] = *it;
+		}
+		if (!sorted)
+			sort_events ();
+		return complete;
+	}
+
+	void sort_events () noexcept
+	{
+		for (size_t i = 0u; i < num_events; ++i)
+			event_order[i] = static_cast<uint32_t> (i);
+		// the index as second key keeps the order of events with the same offset
+		std::sort (event_order.begin (), event_order.begin () + num_events,
+				   [this] (auto lhs, auto rhs) {
+					   auto lhs_offset = events[lhs].sampleOffset;
+					   auto rhs_offset = events[rhs].sampleOffset;
+					   return lhs_offset < rhs_offset || (lhs_offset == rhs_offset && lhs < rhs);
+				   });
+		for (size_t i = 0u; i < num_events; ++i)
+			scratch_events[i] = events[event_order[i]];
+		events.swap (scratch_events);
+	}
+
+	parameter_changes_snapshot changes;
+	std::vector<Event> events;
+	std::vector<uint32_t> event_order;
+	std::vector<Event> scratch_events;
+	size_t num_events {0u};
+	int32 min_size {1};
+};
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+// this file is built as its own executable as it replaces the global allocation functions
+
+#include "vst3utils/parameter.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//------------------------------------------------------------------------
+// counts all heap allocations of the test executable
+static std::atomic<size_t> allocation_count {0u};
+
+void* operator new (std::size_t size)
+{
+	++allocation_count;
+	if (auto p = std::malloc (size ? size : 1u))
+		return p;
+	throw std::bad_alloc ();
+}
+void* operator new[] (std::size_t size) { return operator new (size); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+	++allocation_count;
+	return std::malloc (size ? size : 1u);
+}
+void* operator new[] (std::size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new (size, tag);
+}
+
+void operator delete (void* p) noexcept { std::free (p); }
+void operator delete[] (void* p) noexcept { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept { std::free (p); }
+void operator delete[] (void* p, std::size_t) noexcept { std::free (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept { std::free (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept { std::free (p); }
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+//------------------------------------------------------------------------
+static const param::description gain_desc =
+	param::range_description (u"gain", 0., param::linear_functions<-60, 12> (), 2, u"dB");
+static const param::description mode_desc =
+	param::list_description (u"mode", 1, param::strings_on_off);
+
+//------------------------------------------------------------------------
+template<typename Proc>
+inline double allocations_per_call (size_t iterations, Proc proc)
+{
+	auto start = allocation_count.load ();
+	for (size_t i = 0u; i < iterations; ++i)
+		proc (i);
+	return static_cast<double> (allocation_count.load () - start) /
+		   static_cast<double> (iterations);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST (allocation_test, parameter_string_conversion)
+{
+	constexpr auto iterations = 10000u;
+	parameter gain (0, gain_desc);
+	parameter mode (1, mode_desc);
+	parameter::string_128 str;
+	parameter::param_value value = 0.;
+
+	auto to_string = allocations_per_call (iterations, [&] (size_t i) {
+		gain.toString (static_cast<double> (i) / iterations, str);
+		mode.toString (static_cast<double> (i & 1u), str);
+	});
+	auto from_string = allocations_per_call (iterations, [&] (size_t) {
+		gain.fromString (u"-12.75", value);
+		mode.fromString (u"on", value);
+	});
+	EXPECT_EQ (to_string, 0.);
+	EXPECT_EQ (from_string, 0.);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/buffer_ops.h"
+#include <gtest/gtest.h>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+template<typename T>
+struct buffer_ops_test : ::testing::Test
+{
+	// odd number of samples to test the scalar tail
+	static constexpr size_t num_samples = 67u;
+
+	aligned_buffer<T, 64> in {num_samples + 1};
+	aligned_buffer<T, 64> out {num_samples + 1};
+
+	void SetUp () override
+	{
+		for (auto i = 0u; i < in.size (); ++i)
+			in[i] = static_cast<T> (i) * static_cast<T> (0.25) - static_cast<T> (3);
+		out.fill (static_cast<T> (1));
+	}
+};
+
+using sample_types = ::testing::Types<float, double>;
+TYPED_TEST_SUITE (buffer_ops_test, sample_types);
+
+//------------------------------------------------------------------------
+TYPED_TEST (buffer_ops_test, clear_copy)
+{
+	const auto n = TestFixture::num_samples;
+	clear (this->out.data () + 1, n);
+	EXPECT_EQ (this->out[0], 1);
+	for (auto i = 1u; i <= n; ++i)
+		EXPECT_EQ (this->out[i], 0);
+	copy (this->in.data (), this->out.data (), n);
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_EQ (this->out[i], this->in[i]);
+	copy (this->in.data () + 1, this->out.data (), n);
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_EQ (this->out[i], this->in[i + 1]);
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (buffer_ops_test, fill)
+{
+	using T = TypeParam;
+	const auto n = TestFixture::num_samples;
+	fill (this->out.data () + 1, n, static_cast<T> (3));
+	EXPECT_EQ (this->out[0], 1);
+	for (auto i = 1u; i <= n; ++i)
+		EXPECT_EQ (this->out[i], 3);
+	fill_ramp (this->out.data (), n, static_cast<T> (2), static_cast<T> (0.5));
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_EQ (this->out[i], static_cast<T> (2) + static_cast<T> (i) * static_cast<T> (0.5));
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (buffer_ops_test, gain)
+{
+	using T = TypeParam;
+	const auto n = TestFixture::num_samples;
+	apply_gain (this->in.data (), this->out.data (), n, static_cast<T> (0.5));
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_EQ (this->out[i], this->in[i] * static_cast<T> (0.5));
+	apply_gain (this->in.data () + 1, n, static_cast<T> (2));
+	for (auto i = 1u; i <= n; ++i)
+		EXPECT_EQ (this->in[i], (static_cast<T> (i) * static_cast<T> (0.25) - 3) * 2);
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (buffer_ops_test, gain_ramp)
+{
+	using T = TypeParam;
+	const auto n = TestFixture::num_samples;
+	this->in.fill (static_cast<T> (1));
+	apply_gain_ramp (this->in.data (), this->out.data (), n, static_cast<T> (0), static_cast<T> (1));
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_NEAR (this->out[i], static_cast<T> (i) / static_cast<T> (n), 1e-5);
+	apply_gain_ramp (this->in, static_cast<T> (2), static_cast<T> (2));
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_NEAR (this->in[i], 2, 1e-5);
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (buffer_ops_test, mix)
+{
+	using T = TypeParam;
+	const auto n = TestFixture::num_samples;
+	mix (this->in.data (), this->out.data (), n);
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_EQ (this->out[i], this->in[i] + 1);
+	this->out.fill (static_cast<T> (1));
+	mix (this->in, this->out, static_cast<T> (0.5));
+	for (auto i = 0u; i < n; ++i)
+		EXPECT_EQ (this->out[i], this->in[i] * static_cast<T> (0.5) + 1);
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (buffer_ops_test, interleave)
+{
+	using T = TypeParam;
+	const auto n = TestFixture::num_samples;
+	for (auto num_channels : {1u, 2u, 3u})
+	{
+		multichannel_buffer<T> planar (num_channels, n);
+		multichannel_buffer<T> result (num_channels, n);
+		aligned_buffer<T, 64> interleaved (num_channels * n);
+		for (auto c = 0u; c < num_channels; ++c)
+		{
+			for (auto i = 0u; i < n; ++i)
+				planar[c][i] = static_cast<T> (c * 1000 + i);
+		}
+		interleave (planar.channels (), interleaved.data (), num_channels, n);
+		for (auto i = 0u; i < n; ++i)
+		{
+			for (auto c = 0u; c < num_channels; ++c)
+				EXPECT_EQ (interleaved[i * num_channels + c], planar[c][i]);
+		}
+		deinterleave (interleaved.data (), result.channels (), num_channels, n);
+		for (auto c = 0u; c < num_channels; ++c)
+		{
+			for (auto i = 0u; i < n; ++i)
+				EXPECT_EQ (result[c][i], planar[c][i]);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -73,5 +73,153 @@ TEST (buffer_test, alignment)
 	EXPECT_EQ (ptr % alignment, 0);
 }
 
+//------------------------------------------------------------------------
+TEST (buffer_test, capacity)
+{
+	buffer<double> b (100);
+	auto ptr = b.data ();
+	EXPECT_EQ (b.capacity (), 100);
+	b.allocate (50);
+	EXPECT_EQ (b.size (), 50);
+	EXPECT_EQ (b.capacity (), 100);
+	EXPECT_EQ (b.data (), ptr);
+	b.allocate (100);
+	EXPECT_EQ (b.data (), ptr);
+	b.allocate (200);
+	EXPECT_EQ (b.size (), 200);
+	EXPECT_EQ (b.capacity (), 200);
+	b.release ();
+	EXPECT_EQ (b.size (), 0);
+	EXPECT_EQ (b.capacity (), 0);
+	EXPECT_EQ (b.data (), nullptr);
+}
+
+//------------------------------------------------------------------------
+TEST (buffer_test, reserve_resize)
+{
+	buffer<int> b (4);
+	for (auto i = 0u; i < b.size (); ++i)
+		b[i] = i;
+	b.reserve (100);
+	EXPECT_EQ (b.size (), 4);
+	EXPECT_EQ (b.capacity (), 100);
+	auto ptr = b.data ();
+	b.resize (8);
+	EXPECT_EQ (b.data (), ptr);
+	EXPECT_EQ (b.size (), 8);
+	for (auto i = 0u; i < 4; ++i)
+		EXPECT_EQ (b[i], i);
+	for (auto i = 4u; i < 8; ++i)
+		EXPECT_EQ (b[i], 0);
+	b.resize (200);
+	EXPECT_EQ (b.size (), 200);
+	EXPECT_EQ (b[3], 3);
+	b.resize (2);
+	EXPECT_EQ (b.size (), 2);
+	EXPECT_EQ (b.capacity (), 200);
+}
+
+//------------------------------------------------------------------------
+TEST (buffer_test, move_swap)
+{
+	buffer<float> a (10);
+	a.fill (1.f);
+	auto ptr = a.data ();
+	buffer<float> b (std::move (a));
+	EXPECT_EQ (a.data (), nullptr);
+	EXPECT_EQ (a.size (), 0);
+	EXPECT_EQ (b.data (), ptr);
+	EXPECT_EQ (b.size (), 10);
+
+	buffer<float> c (20);
+	auto ptr_c = c.data ();
+	swap (b, c);
+	EXPECT_EQ (b.data (), ptr_c);
+	EXPECT_EQ (b.size (), 20);
+	EXPECT_EQ (c.data (), ptr);
+	EXPECT_EQ (c.size (), 10);
+
+	a = std::move (c);
+	EXPECT_EQ (a.data (), ptr);
+	EXPECT_EQ (c.data (), nullptr);
+
+	static_assert (std::is_nothrow_move_constructible_v<buffer<float>>);
+	static_assert (std::is_nothrow_move_assignable_v<aligned_buffer<float, 32>>);
+}
+
+//------------------------------------------------------------------------
+TEST (multichannel_buffer_test, allocate)
+{
+	multichannel_buffer<float> b (4, 100);
+	EXPECT_EQ (b.num_channels (), 4);
+	EXPECT_EQ (b.num_samples (), 100);
+	EXPECT_EQ (b.stride () % (cache_line_size / sizeof (float)), 0);
+	EXPECT_GE (b.stride (), b.num_samples ());
+	for (auto i = 0u; i < b.num_channels (); ++i)
+	{
+		EXPECT_EQ (b.channels ()[i], b[i]);
+		EXPECT_EQ (b[i], b[0] + i * b.stride ());
+	}
+	b.allocate (0, 100);
+	EXPECT_EQ (b.num_channels (), 0);
+	EXPECT_EQ (b.num_samples (), 0);
+}
+
+//------------------------------------------------------------------------
+TEST (multichannel_buffer_test, alignment)
+{
+	constexpr auto alignment = 128u;
+	multichannel_buffer<double, alignment> b (3, 17);
+	for (auto i = 0u; i < b.num_channels (); ++i)
+	{
+		auto ptr = reinterpret_cast<intptr_t> (b[i]);
+		EXPECT_EQ (ptr % alignment, 0);
+	}
+}
+
+//------------------------------------------------------------------------
+TEST (multichannel_buffer_test, fill)
+{
+	multichannel_buffer<float> b (2, 33);
+	b.fill (0.5f);
+	for (auto c = 0u; c < b.num_channels (); ++c)
+	{
+		for (auto i = 0u; i < b.num_samples (); ++i)
+			EXPECT_FLOAT_EQ (b[c][i], 0.5f);
+	}
+	b.clear ();
+	for (auto c = 0u; c < b.num_channels (); ++c)
+	{
+		for (auto i = 0u; i < b.num_samples (); ++i)
+			EXPECT_FLOAT_EQ (b[c][i], 0.f);
+	}
+}
+
+//------------------------------------------------------------------------
+TEST (multichannel_buffer_test, assign_to_bus)
+{
+	struct bus_mock
+	{
+		int32_t numChannels {};
+		uint64_t silenceFlags {};
+		union
+		{
+			float** channelBuffers32;
+			double** channelBuffers64;
+		};
+	};
+
+	multichannel_buffer<float> b32 (2, 64);
+	bus_mock bus {};
+	b32.assign_to (bus);
+	EXPECT_EQ (bus.numChannels, 2);
+	EXPECT_EQ (bus.channelBuffers32, b32.channels ());
+
+	multichannel_buffer<double> b64 (6, 64);
+	b64.assign_to (bus);
+	EXPECT_EQ (bus.numChannels, 6);
+	EXPECT_EQ (bus.channelBuffers64, b64.channels ());
+}
+
 //------------------------------------------------------------------------
 } // vst3utils
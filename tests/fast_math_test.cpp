@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/fast_math.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+template<typename T>
+struct fast_math_test : ::testing::Test
+{
+	using vec = simd::vec<T>;
+
+	// the documented maximum errors of fast_math.h
+	static constexpr T exp2_error = sizeof (T) == 4u ? 4e-7 : 6e-16;
+	static constexpr T log2_error = sizeof (T) == 4u ? 2e-7 : 5e-16;
+
+	/** checks that the scalar and the vector version return the same values */
+	template<typename Func>
+	static T eval (T x, Func&& func)
+	{
+		alignas (64) T in[vec::size];
+		alignas (64) T out[vec::size];
+		std::fill_n (in, vec::size, x);
+		func (vec::load (in)).store (out);
+		auto result = func (x);
+		for (auto i = 0u; i < vec::size; ++i)
+			EXPECT_EQ (out[i], result);
+		return result;
+	}
+};
+
+using sample_types = ::testing::Types<float, double>;
+TYPED_TEST_SUITE (fast_math_test, sample_types);
+
+//------------------------------------------------------------------------
+TYPED_TEST (fast_math_test, exp2)
+{
+	using T = TypeParam;
+	for (auto x = -100.; x <= 100.; x += 0.01)
+	{
+		auto arg = static_cast<T> (x);
+		auto result = this->eval (arg, [] (auto v) { return simd::exp2 (v); });
+		auto expected = std::exp2 (static_cast<long double> (arg));
+		EXPECT_LE (std::abs (result - expected) / expected, TestFixture::exp2_error) << arg;
+	}
+	EXPECT_EQ (simd::exp2 (static_cast<T> (0)), static_cast<T> (1));
+	EXPECT_EQ (simd::exp2 (static_cast<T> (10)), static_cast<T> (1024));
+	EXPECT_EQ (simd::exp2 (static_cast<T> (-3)), static_cast<T> (0.125));
+	// out of range inputs are clamped
+	EXPECT_TRUE (std::isfinite (simd::exp2 (static_cast<T> (1e6))));
+	EXPECT_GE (simd::exp2 (static_cast<T> (-1e6)), static_cast<T> (0));
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (fast_math_test, log2)
+{
+	using T = TypeParam;
+	for (auto x = 1e-30; x <= 1e30; x *= 1.0123)
+	{
+		auto arg = static_cast<T> (x);
+		auto result = this->eval (arg, [] (auto v) { return simd::log2 (v); });
+		auto expected = std::log2 (static_cast<long double> (arg));
+		auto tolerance = TestFixture::log2_error * std::max (std::abs (expected), 1.l);
+		EXPECT_LE (std::abs (result - expected), tolerance) << arg;
+	}
+	for (auto x = 0.5; x <= 2.; x += 0.0001)
+	{
+		auto arg = static_cast<T> (x);
+		auto expected = std::log2 (static_cast<long double> (arg));
+		EXPECT_LE (std::abs (simd::log2 (arg) - expected), TestFixture::log2_error) << arg;
+	}
+	EXPECT_EQ (simd::log2 (static_cast<T> (1)), static_cast<T> (0));
+	EXPECT_EQ (simd::log2 (static_cast<T> (1024)), static_cast<T> (10));
+	// zero is clamped to the smallest normal number
+	EXPECT_EQ (simd::log2 (static_cast<T> (0)),
+			   static_cast<T> (std::numeric_limits<T>::min_exponent - 1));
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (fast_math_test, exp_log_pow)
+{
+	using T = TypeParam;
+	const auto tolerance = TestFixture::exp2_error * 16;
+	for (auto x = -10.; x <= 10.; x += 0.1)
+	{
+		auto arg = static_cast<T> (x);
+		auto expected = std::exp (static_cast<long double> (arg));
+		EXPECT_LE (std::abs (simd::exp (arg) - expected) / expected, tolerance) << arg;
+	}
+	for (auto x = 0.001; x <= 1000.; x *= 1.1)
+	{
+		auto arg = static_cast<T> (x);
+		auto expected = std::log (static_cast<long double> (arg));
+		EXPECT_LE (std::abs (simd::log (arg) - expected),
+				   tolerance * std::max (std::abs (expected), 1.l))
+			<< arg;
+		auto p = simd::pow (arg, static_cast<T> (1.5));
+		auto expected_pow = std::pow (static_cast<long double> (arg), 1.5l);
+		EXPECT_LE (std::abs (p - expected_pow) / expected_pow, tolerance) << arg;
+	}
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
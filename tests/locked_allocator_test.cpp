@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/locked_allocator.h"
+#include <gtest/gtest.h>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+TEST (locked_allocator_test, allocate)
+{
+	locked_memory_stats stats;
+	{
+		locked_buffer<float> b (1000, {locked_allocator::prefault, &stats});
+		EXPECT_EQ (b.size (), 1000);
+		EXPECT_EQ (reinterpret_cast<intptr_t> (b.data ()) % cache_line_size, 0);
+		b.fill (1.f);
+		EXPECT_FLOAT_EQ (b[999], 1.f);
+		EXPECT_GE (stats.allocated_bytes, 1000 * sizeof (float));
+		EXPECT_EQ (stats.locked_bytes, 0);
+	}
+	EXPECT_EQ (stats.allocated_bytes, 0);
+}
+
+//------------------------------------------------------------------------
+TEST (locked_allocator_test, lock)
+{
+	locked_memory_stats stats;
+	auto total = locked_allocator::total_locked_bytes ();
+	{
+		locked_buffer<double> b (
+			4096, {locked_allocator::prefault | locked_allocator::lock | locked_allocator::huge_pages,
+				   &stats});
+		EXPECT_EQ (b.size (), 4096);
+		b.fill (0.5);
+		// locking may fail because of the lock limit of the process
+		if (stats.locked_bytes > 0)
+		{
+			EXPECT_EQ (stats.locked_bytes, stats.allocated_bytes);
+			EXPECT_EQ (locked_allocator::total_locked_bytes (), total + stats.locked_bytes);
+		}
+	}
+	EXPECT_EQ (stats.locked_bytes, 0);
+	EXPECT_EQ (locked_allocator::total_locked_bytes (), total);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
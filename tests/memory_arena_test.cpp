@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/memory_arena.h"
+#include <gtest/gtest.h>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+TEST (memory_arena_test, allocate)
+{
+	memory_arena<32> arena (1024);
+	EXPECT_EQ (arena.capacity (), 1024);
+	auto p1 = arena.allocate (10);
+	EXPECT_NE (p1, nullptr);
+	EXPECT_EQ (reinterpret_cast<intptr_t> (p1) % 32, 0);
+	EXPECT_EQ (arena.used (), 32);
+	auto p2 = arena.allocate (33);
+	EXPECT_EQ (reinterpret_cast<intptr_t> (p2) % 32, 0);
+	EXPECT_EQ (static_cast<uint8_t*> (p2) - static_cast<uint8_t*> (p1), 32);
+	EXPECT_EQ (arena.used (), 96);
+	EXPECT_EQ (arena.allocate (2048), nullptr);
+	arena.reset ();
+	EXPECT_EQ (arena.used (), 0);
+	EXPECT_EQ (arena.allocate (10), p1);
+}
+
+//------------------------------------------------------------------------
+TEST (memory_arena_test, deallocate_last)
+{
+	memory_arena<16> arena (256);
+	auto p1 = arena.allocate (16);
+	auto p2 = arena.allocate (16);
+	arena.deallocate (p1, 16);
+	EXPECT_EQ (arena.used (), 32);
+	arena.deallocate (p2, 16);
+	EXPECT_EQ (arena.used (), 16);
+	arena.deallocate (p1, 16);
+	EXPECT_EQ (arena.used (), 0);
+}
+
+//------------------------------------------------------------------------
+TEST (memory_arena_test, frame)
+{
+	memory_arena<> arena (4096);
+	arena.allocate (100);
+	auto used = arena.used ();
+	{
+		memory_arena<>::frame frame (arena);
+		arena.allocate (100);
+		arena.allocate (200);
+		EXPECT_GT (arena.used (), used);
+	}
+	EXPECT_EQ (arena.used (), used);
+}
+
+//------------------------------------------------------------------------
+TEST (memory_arena_test, buffer)
+{
+	memory_arena<> arena (4096);
+	{
+		arena_buffer<float> b (100, {&arena});
+		EXPECT_EQ (b.size (), 100);
+		EXPECT_EQ (reinterpret_cast<intptr_t> (b.data ()) % cache_line_size, 0);
+		b.fill (1.f);
+		EXPECT_EQ (arena.used (), 448);
+
+		arena_buffer<double> too_large (4096, {&arena});
+		EXPECT_EQ (too_large.size (), 0);
+	}
+	EXPECT_EQ (arena.used (), 0);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -8,6 +8,7 @@
 
 #include "vst3utils/norm_plain_conversion.h"
 #include <gtest/gtest.h>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace vst3utils {
@@ -130,5 +131,151 @@ TEST (norm_plain_conversion_test, exp_to_normalized)
 	EXPECT_DOUBLE_EQ (std::round (norm * 100.) / 100., 0.9);
 }
 
+//------------------------------------------------------------------------
+TEST (norm_plain_conversion_test, exp_mapping)
+{
+	static constexpr exp_mapping<double> mapping {80., 22050.};
+	static_assert (mapping.to_plain (0.) - 80. < 1e-9);
+	static_assert (mapping.to_normalized (80.) < 1e-12);
+	constexpr auto compile_time = mapping.to_plain (0.5);
+
+	EXPECT_NEAR (mapping.to_plain (0.5), compile_time, 1e-9);
+	for (auto i = 0; i <= 100; ++i)
+	{
+		auto norm = i / 100.;
+		auto plain = mapping.to_plain (norm);
+		EXPECT_NEAR (plain, normalized_to_exp (80., 22050., norm), 1e-9);
+		EXPECT_NEAR (mapping.to_normalized (plain), norm, 1e-12);
+		EXPECT_NEAR (mapping.to_normalized (plain), exp_to_normalized (80., 22050., plain), 1e-12);
+	}
+	EXPECT_EQ (mapping.to_plain (1.), 22050.);
+	EXPECT_EQ (mapping.to_normalized (10.), 0.);
+	EXPECT_EQ (mapping.to_normalized (30000.), 1.);
+
+	exp_mapping<float> zero_mapping {0.f, 100.f};
+	EXPECT_EQ (zero_mapping.to_plain (0.f), 0.f);
+	EXPECT_NEAR (zero_mapping.to_plain (1.f), 100.f, 1e-4f);
+	EXPECT_EQ (zero_mapping.to_normalized (0.f), 0.f);
+	EXPECT_NEAR (zero_mapping.to_normalized (zero_mapping.to_plain (0.5f)), 0.5f, 1e-6f);
+}
+
+//------------------------------------------------------------------------
+TEST (norm_plain_conversion_test, batch_conversions)
+{
+	constexpr auto num_values = 101u;
+	std::vector<double> normalized (num_values);
+	std::vector<double> out (num_values);
+	std::vector<double> back (num_values);
+	for (auto i = 0u; i < num_values; ++i)
+		normalized[i] = i / 100.;
+
+	normalized_to_plain (-200., 200., normalized.data (), out.data (), num_values);
+	for (auto i = 0u; i < num_values; ++i)
+		EXPECT_DOUBLE_EQ (out[i], normalized_to_plain (-200., 200., normalized[i]));
+
+	normalized_to_exp (80., 22050., normalized.data (), out.data (), num_values);
+	exp_to_normalized (80., 22050., out.data (), back.data (), num_values);
+	for (auto i = 0u; i < num_values; ++i)
+	{
+		EXPECT_NEAR (out[i], 80. * std::pow (22050. / 80., normalized[i]), 1e-10);
+		EXPECT_NEAR (back[i], normalized[i], 1e-14);
+	}
+	EXPECT_EQ (out[0], 80.);
+	EXPECT_EQ (out[num_values - 1], 22050.);
+
+	normalized_to_exp (0., 100., normalized.data (), out.data (), num_values);
+	EXPECT_EQ (out[0], 0.);
+	EXPECT_NEAR (out[num_values - 1], 100., 1e-12);
+
+	std::vector<float> db (num_values);
+	std::vector<float> gain (num_values);
+	std::vector<float> db_back (num_values);
+	for (auto i = 0u; i < num_values; ++i)
+		db[i] = -144.f + 1.68f * i;
+	db_to_gain (db.data (), gain.data (), num_values);
+	gain_to_db (gain.data (), db_back.data (), num_values);
+	for (auto i = 0u; i < num_values; ++i)
+	{
+		auto expected = std::pow (10., db[i] / 20.);
+		EXPECT_NEAR (gain[i], expected, expected * 1e-5);
+		EXPECT_NEAR (db_back[i], db[i], 1e-4);
+	}
+}
+
+//------------------------------------------------------------------------
+template<db_precision precision, typename T>
+void test_db_precision (double max_db_error)
+{
+	constexpr auto num_values = 16801u;
+	std::vector<T> db (num_values);
+	std::vector<T> gain (num_values);
+	std::vector<T> db_back (num_values);
+	for (auto i = 0u; i < num_values; ++i)
+		db[i] = static_cast<T> (-144. + i * 0.01);
+	db_to_gain<precision> (db.data (), gain.data (), num_values);
+	gain_to_db<precision> (gain.data (), db_back.data (), num_values);
+	for (auto i = 0u; i < num_values; ++i)
+	{
+		auto exact_gain = std::pow (10., static_cast<double> (db[i]) / 20.);
+		auto gain_error_db = std::abs (20. * std::log10 (gain[i] / exact_gain));
+		ASSERT_LE (gain_error_db, max_db_error) << db[i];
+		auto exact_db = 20. * std::log10 (static_cast<double> (gain[i]));
+		ASSERT_LE (std::abs (db_back[i] - exact_db), max_db_error) << db[i];
+		EXPECT_EQ (gain[i], fast_db_to_gain<precision> (db[i]));
+		EXPECT_EQ (db_back[i], fast_gain_to_db<precision> (gain[i]));
+	}
+}
+
+//------------------------------------------------------------------------
+TEST (norm_plain_conversion_test, db_precision)
+{
+	test_db_precision<db_precision::exact, float> (1e-4);
+	test_db_precision<db_precision::exact, double> (1e-12);
+	test_db_precision<db_precision::hundredth_db, float> (0.01);
+	test_db_precision<db_precision::hundredth_db, double> (0.01);
+	test_db_precision<db_precision::tenth_db, float> (0.1);
+	test_db_precision<db_precision::tenth_db, double> (0.1);
+
+	EXPECT_EQ (fast_gain_to_db<db_precision::tenth_db> (1.f), 0.f);
+	EXPECT_EQ (fast_db_to_gain<db_precision::tenth_db> (0.f), 1.f);
+	EXPECT_LT (fast_gain_to_db<db_precision::hundredth_db> (0.), -6000.);
+}
+
+//------------------------------------------------------------------------
+TEST (norm_plain_conversion_test, step_mapping)
+{
+	constexpr step_mapping mapping (4, 10);
+	static_assert (mapping.to_steps (1.) == 14);
+	static_assert (mapping.to_normalized (12) == 0.5);
+
+	constexpr auto num_values = 1001u;
+	std::vector<float> normalized (num_values + 2);
+	std::vector<int32_t> steps (num_values + 2);
+	std::vector<float> quantized (num_values + 2);
+	for (auto i = 0u; i < num_values; ++i)
+		normalized[i] = i / static_cast<float> (num_values - 1);
+	normalized[num_values] = -0.5f;
+	normalized[num_values + 1] = 1.5f;
+
+	mapping.to_steps (normalized.data (), steps.data (), normalized.size ());
+	mapping.quantize (normalized.data (), quantized.data (), normalized.size ());
+	for (auto i = 0u; i < num_values; ++i)
+	{
+		auto expected = normalized_to_steps (4, 10, normalized[i]);
+		EXPECT_EQ (steps[i], expected) << normalized[i];
+		EXPECT_EQ (steps[i], mapping.to_steps (normalized[i]));
+		EXPECT_FLOAT_EQ (quantized[i], steps_to_normalized<float> (4, 10, expected));
+	}
+	EXPECT_EQ (steps[num_values], 10);
+	EXPECT_EQ (steps[num_values + 1], 14);
+	EXPECT_EQ (quantized[num_values], 0.f);
+	EXPECT_EQ (quantized[num_values + 1], 1.f);
+
+	std::vector<double> back (num_values);
+	mapping.to_normalized (steps.data (), back.data (), num_values);
+	for (auto i = 0u; i < num_values; ++i)
+		EXPECT_DOUBLE_EQ (back[i], steps_to_normalized (4, 10, steps[i]));
+}
+
 //------------------------------------------------------------------------
 } // vst3utils
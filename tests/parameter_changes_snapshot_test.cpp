@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/parameter_changes_snapshot.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+//------------------------------------------------------------------------
+void add_changes (ParameterChanges& changes)
+{
+	int32 index;
+	auto queue = changes.addParameterData (7, index);
+	queue->addPoint (0, 0.1, index);
+	queue->addPoint (32, 0.2, index);
+	changes.addParameterData (3, index)->addPoint (16, 0.3, index);
+	queue = changes.addParameterData (5, index);
+	queue->addPoint (0, 0.4, index);
+	queue->addPoint (16, 0.5, index);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST (parameter_changes_snapshot_test, queue_order)
+{
+	ParameterChanges changes;
+	add_changes (changes);
+	parameter_changes_snapshot snapshot;
+	snapshot.setup (16);
+	EXPECT_TRUE (snapshot.capture (&changes));
+	ASSERT_EQ (snapshot.size (), 5u);
+	std::vector<ParamID> pids (snapshot.pid_data (), snapshot.pid_data () + snapshot.size ());
+	EXPECT_EQ (pids, (std::vector<ParamID> {7, 7, 3, 5, 5}));
+	EXPECT_EQ (snapshot.sample_offset (1), 32);
+	EXPECT_EQ (snapshot.value (1), 0.2);
+
+	EXPECT_TRUE (snapshot.capture (nullptr));
+	EXPECT_TRUE (snapshot.empty ());
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_changes_snapshot_test, sorted)
+{
+	ParameterChanges changes;
+	add_changes (changes);
+	parameter_changes_snapshot snapshot;
+	snapshot.setup (16);
+	EXPECT_TRUE (snapshot.capture (&changes, true));
+	ASSERT_EQ (snapshot.size (), 5u);
+	std::vector<std::pair<ParamID, int32>> points;
+	for (size_t i = 0u; i < snapshot.size (); ++i)
+		points.emplace_back (snapshot.pid (i), snapshot.sample_offset (i));
+	EXPECT_EQ (points, (std::vector<std::pair<ParamID, int32>> {
+						   {7, 0}, {5, 0}, {3, 16}, {5, 16}, {7, 32}}));
+	EXPECT_EQ (snapshot.value (1), 0.4);
+	EXPECT_EQ (snapshot.value (4), 0.2);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_changes_snapshot_test, capacity)
+{
+	ParameterChanges changes;
+	add_changes (changes);
+	parameter_changes_snapshot snapshot;
+	snapshot.setup (3);
+	EXPECT_FALSE (snapshot.capture (&changes));
+	EXPECT_EQ (snapshot.size (), 3u);
+	EXPECT_EQ (snapshot.pid (2), 3u);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/parameter_description.h"
+#include <gtest/gtest.h>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace param {
+
+//------------------------------------------------------------------------
+TEST (parameter_description_test, lookup_table)
+{
+	constexpr auto exp_func = make_normalized_to_exp_func<20, 20000> ();
+	using table = lookup_table<make_normalized_to_exp_func<20, 20000>, 512>;
+	static_assert (table::values.size () == 512u);
+	static_assert (table::max_error > 0. && table::max_error < 0.5);
+	static_assert (table::to_plain (0.) == table::values[0]);
+	static_assert (table::to_plain (1.) == table::values[511]);
+
+	EXPECT_NEAR (table::to_plain (0.), 20., 1e-9);
+	EXPECT_NEAR (table::to_plain (1.), 20000., 1e-9);
+	EXPECT_EQ (table::to_plain (-1.), table::to_plain (0.));
+	EXPECT_EQ (table::to_plain (2.), table::to_plain (1.));
+	for (auto i = 0; i <= 1000; ++i)
+	{
+		auto norm = i / 1000.;
+		EXPECT_NEAR (table::to_plain (norm), exp_func (norm), table::max_error * 1.01);
+	}
+
+	// a linear curve is reproduced exactly
+	using linear_table = lookup_table<make_normalized_to_plain_func<-50, 50>, 3>;
+	static_assert (linear_table::max_error == 0.);
+	EXPECT_DOUBLE_EQ (linear_table::to_plain (0.25), -25.);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_description_test, lookup_table_description)
+{
+	static constexpr auto functions =
+		lookup_table_functions<make_normalized_to_exp_func<20, 20000>,
+							   make_exp_to_normalized_func<20, 20000>, 1024> ();
+	static const auto desc = range_description (u"cutoff", 1000., functions, 0, u"Hz");
+
+	auto range = std::get<param::range> (desc.range_or_step_count);
+	EXPECT_NEAR (range.min, 20., 1e-9);
+	EXPECT_NEAR (range.max, 20000., 1e-9);
+	EXPECT_NEAR (desc.convert.to_plain (desc.default_normalized), 1000., 0.5);
+	EXPECT_NEAR (desc.convert.to_normalized (desc.convert.to_plain (0.3)), 0.3, 1e-4);
+}
+
+//------------------------------------------------------------------------
+} // param
+} // vst3utils
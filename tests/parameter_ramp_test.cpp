@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/parameter_ramp.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include <gtest/gtest.h>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+//------------------------------------------------------------------------
+TEST (parameter_ramp_test, no_changes)
+{
+	parameter_ramp<float> ramp (0.5f);
+	ramp.setup (32);
+	auto curve = ramp.process (nullptr, 32);
+	EXPECT_TRUE (ramp.is_constant ());
+	EXPECT_EQ (ramp.size (), 32);
+	for (auto i = 0; i < 32; ++i)
+		EXPECT_EQ (curve[i], 0.5f);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_ramp_test, ramps)
+{
+	parameter_ramp<double> ramp (0.);
+	ramp.setup (64);
+	ParameterValueQueue queue (0);
+	int32 index;
+	queue.addPoint (3, 1., index);
+	queue.addPoint (11, 0.5, index);
+	auto curve = ramp.process (&queue, 16);
+	EXPECT_FALSE (ramp.is_constant ());
+	// from the previous value one sample before the block to the first point
+	EXPECT_DOUBLE_EQ (curve[0], 0.25);
+	EXPECT_DOUBLE_EQ (curve[1], 0.5);
+	EXPECT_DOUBLE_EQ (curve[2], 0.75);
+	EXPECT_EQ (curve[3], 1.);
+	for (auto i = 4; i < 11; ++i)
+		EXPECT_DOUBLE_EQ (curve[i], 1. - 0.5 * (i - 3) / 8.);
+	for (auto i = 11; i < 16; ++i)
+		EXPECT_EQ (curve[i], 0.5);
+	EXPECT_EQ (ramp.get_value (), 0.5);
+
+	curve = ramp.process (nullptr, 8);
+	EXPECT_TRUE (ramp.is_constant ());
+	for (auto i = 0; i < 8; ++i)
+		EXPECT_EQ (curve[i], 0.5);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_ramp_test, first_point_at_zero)
+{
+	parameter_ramp<float> ramp (1.f);
+	ramp.setup (16);
+	ParameterValueQueue queue (0);
+	int32 index;
+	queue.addPoint (0, 0.25, index);
+	queue.addPoint (40, 1., index);
+	auto curve = ramp.process (&queue, 16);
+	EXPECT_EQ (curve[0], 0.25f);
+	// points after the block end are clamped to the last sample
+	EXPECT_EQ (curve[15], 1.f);
+	EXPECT_FLOAT_EQ (curve[1], 0.25f + 0.75f / 15.f);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/parameter_registry.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+using Flags = Steinberg::Vst::ParameterInfo::ParameterFlags;
+
+//------------------------------------------------------------------------
+static constexpr std::array<param::description, 3> descriptions = {{
+	param::list_description (u"bypass", 1, param::strings_on_off),
+	param::range_description (u"gain", -6., param::linear_functions<-60, 12> (), 1, u"dB"),
+	param::range_description (u"pan", 0., param::linear_functions<-100, 100> (), 0),
+}};
+static constexpr std::array<Steinberg::Vst::ParamID, 3> ids = {100, 2000, 30000};
+static constexpr parameter_registry registry {descriptions, ids};
+
+//------------------------------------------------------------------------
+template<size_t... I>
+constexpr std::array<param::description, sizeof...(I)> make_descriptions (
+	std::index_sequence<I...>)
+{
+	return {{(static_cast<void> (I), descriptions[I % descriptions.size ()])...}};
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST (parameter_registry_test, constexpr_registry)
+{
+	static_assert (registry.size () == 3u);
+	static_assert (registry.index_of (100) == 0u);
+	static_assert (registry.index_of (2000) == 1u);
+	static_assert (registry.index_of (30000) == 2u);
+	static_assert (registry.index_of (0) == registry.size ());
+	static_assert (registry.find (2001) == nullptr);
+	static_assert (registry[0].flags == (Flags::kCanAutomate | Flags::kIsList));
+	static_assert (registry[0].step_count == 1);
+	static_assert (registry[0].default_plain == 1.);
+	static_assert (registry[1].flags == Flags::kCanAutomate);
+	static_assert (registry[1].step_count == 0);
+
+	EXPECT_NEAR (registry[1].default_plain, -6., 1e-9);
+	EXPECT_EQ (registry.find (30000), &registry[2]);
+	EXPECT_EQ (registry[2].description, &descriptions[2]);
+
+	size_t count = 0u;
+	for (const auto& entry : registry)
+		EXPECT_EQ (registry.index_of (entry.id), count++);
+	EXPECT_EQ (count, 3u);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_registry_test, index_as_id)
+{
+	constexpr parameter_registry indexed {descriptions, Flags::kNoFlags};
+	static_assert (indexed.index_of (0) == 0u);
+	static_assert (indexed.index_of (2) == 2u);
+	static_assert (indexed.index_of (3) == 3u);
+	static_assert (indexed[0].flags == Flags::kIsList);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_registry_test, info)
+{
+	auto info = registry.info (1);
+	EXPECT_EQ (info.id, 2000u);
+	EXPECT_EQ (info.stepCount, 0);
+	EXPECT_EQ (info.flags, Flags::kCanAutomate);
+	EXPECT_DOUBLE_EQ (info.defaultNormalizedValue, descriptions[1].default_normalized);
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (info.title)), u"gain");
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (info.units)), u"dB");
+
+	info = registry.info (0);
+	EXPECT_EQ (info.stepCount, 1);
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (info.units)), u"");
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_registry_test, sparse_ids)
+{
+	constexpr size_t num = 4000u;
+	static constexpr auto many = make_descriptions (std::make_index_sequence<num> ());
+	std::array<Steinberg::Vst::ParamID, num> sparse_ids {};
+	for (size_t i = 0u; i < num; ++i)
+		sparse_ids[i] = static_cast<Steinberg::Vst::ParamID> (i * 7919u + 13u);
+
+	auto large = std::make_unique<parameter_registry<num>> (many, sparse_ids);
+	for (size_t i = 0u; i < num; ++i)
+	{
+		EXPECT_EQ (large->index_of (sparse_ids[i]), i);
+		EXPECT_EQ (large->index_of (sparse_ids[i] + 1u), num);
+	}
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/parameter_state.h"
+#include "vst3utils/smooth_value.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+//------------------------------------------------------------------------
+static constexpr std::array<param::description, 3> descriptions = {{
+	param::list_description (u"bypass", 0, param::strings_on_off),
+	param::range_description (u"gain", 0., param::linear_functions<-60, 12> (), 1, u"dB"),
+	param::range_description (u"pan", 0., param::linear_functions<-100, 100> (), 0),
+}};
+static constexpr std::array<ParamID, 3> ids = {10, 20, 30};
+static constexpr parameter_registry registry {descriptions, ids};
+
+//------------------------------------------------------------------------
+template<size_t N>
+std::vector<size_t> dirty_indices (const parameter_state<N>& state)
+{
+	std::vector<size_t> result;
+	state.for_each_dirty ([&] (size_t index) { result.push_back (index); });
+	return result;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST (parameter_state_test, defaults)
+{
+	parameter_state<3> state {registry};
+	EXPECT_EQ (state.normalized (0), 0.);
+	EXPECT_EQ (state.plain (0), 0.);
+	EXPECT_DOUBLE_EQ (state.plain (1), 0.);
+	EXPECT_DOUBLE_EQ (state.normalized (2), 0.5);
+	EXPECT_EQ (dirty_indices (state), (std::vector<size_t> {0, 1, 2}));
+
+	state.clear_dirty ();
+	EXPECT_FALSE (state.any_dirty ());
+	EXPECT_TRUE (dirty_indices (state).empty ());
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_state_test, update)
+{
+	parameter_state<3> state {registry};
+	state.clear_dirty ();
+
+	ParameterChanges changes;
+	int32 index;
+	auto queue = changes.addParameterData (30, index);
+	queue->addPoint (0, 0., index);
+	queue->addPoint (8, 1., index);
+	changes.addParameterData (99, index)->addPoint (0, 1., index);
+	changes.addParameterData (10, index)->addPoint (4, 0., index);
+	EXPECT_EQ (state.update (&changes), 1u);
+	EXPECT_EQ (state.normalized (2), 1.);
+	EXPECT_DOUBLE_EQ (state.plain (2), 100.);
+	EXPECT_TRUE (state.is_dirty (2));
+	EXPECT_FALSE (state.is_dirty (0));
+	EXPECT_EQ (dirty_indices (state), (std::vector<size_t> {2}));
+
+	state.clear_dirty ();
+	changes.clearQueue ();
+	changes.addParameterData (10, index)->addPoint (4, 1., index);
+	EXPECT_EQ (state.update (&changes), 1u);
+	EXPECT_EQ (state.plain (0), 1.);
+	EXPECT_EQ (dirty_indices (state), (std::vector<size_t> {0}));
+
+	state.reset ();
+	EXPECT_EQ (state.normalized (0), 0.);
+	EXPECT_EQ (dirty_indices (state), (std::vector<size_t> {0, 1, 2}));
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_state_test, word_boundaries)
+{
+	static const std::array<param::description, 130> many {};
+	static const parameter_registry many_registry {many};
+	auto state = std::make_unique<parameter_state<130>> (many_registry);
+	EXPECT_EQ (dirty_indices (*state).size (), 130u);
+
+	state->clear_dirty ();
+	for (auto index : {0u, 63u, 64u, 129u})
+		EXPECT_TRUE (state->set_normalized (index, 1.));
+	EXPECT_FALSE (state->set_normalized (64, 1.));
+	EXPECT_EQ (dirty_indices (*state), (std::vector<size_t> {0, 63, 64, 129}));
+	EXPECT_EQ (state->plain (129), 1.);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_state_test, drive_smoothers)
+{
+	parameter_state<3> state {registry};
+	smooth_value_bank<double, 3> smoothers;
+	state.clear_dirty ();
+	state.set_normalized (2, 1.);
+	state.for_each_dirty ([&] (size_t index) { smoothers.set (index, state.plain (index)); });
+	EXPECT_TRUE (smoothers.is_settled (0));
+	EXPECT_FALSE (smoothers.is_settled (2));
+	EXPECT_DOUBLE_EQ (smoothers.get (2), 100.);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
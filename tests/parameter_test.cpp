@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/parameter.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+//------------------------------------------------------------------------
+static const param::description gain_desc =
+	param::range_description (u"gain", 0., param::linear_functions<-60, 12> (), 2, u"dB");
+static const param::description mode_desc =
+	param::list_description (u"mode", 1, param::strings_on_off);
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST (parameter_test, to_string)
+{
+	parameter gain (0, gain_desc);
+	parameter::string_128 str;
+	gain.toString (gain.toNormalized (-6.5), str);
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (str)), u"-6.50");
+	gain.toString (1., str);
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (str)), u"12.00");
+
+	parameter mode (1, mode_desc);
+	mode.toString (0., str);
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (str)), u"off");
+	mode.toString (1., str);
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (str)), u"on");
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_test, from_string)
+{
+	parameter gain (0, gain_desc);
+	parameter::param_value value = 0.;
+	EXPECT_TRUE (gain.fromString (u"-24.25", value));
+	EXPECT_DOUBLE_EQ (gain.toPlain (value), -24.25);
+	// non ASCII characters are ignored
+	EXPECT_TRUE (gain.fromString (u"3.5\u00B0", value));
+	EXPECT_DOUBLE_EQ (gain.toPlain (value), 3.5);
+	EXPECT_FALSE (gain.fromString (u"loud", value));
+
+	parameter mode (1, mode_desc);
+	EXPECT_TRUE (mode.fromString (u"off", value));
+	EXPECT_EQ (value, 0.);
+	EXPECT_TRUE (mode.fromString (u"on", value));
+	EXPECT_EQ (value, 1.);
+	EXPECT_FALSE (mode.fromString (u"maybe", value));
+
+	// list parameters with a start value other than zero
+	static const std::array<const char16_t*, 3> strings = {u"low", u"mid", u"high"};
+	static const param::description band_desc {u"band", 0., param::make_step_count (strings, 1)};
+	parameter band (2, band_desc);
+	EXPECT_TRUE (band.fromString (u"high", value));
+	EXPECT_EQ (value, 1.);
+	EXPECT_EQ (band.toPlain (value), 3.);
+	parameter::string_128 str;
+	band.toString (0.5, str);
+	EXPECT_EQ (std::u16string (reinterpret_cast<const char16_t*> (str)), u"mid");
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_test, listener)
+{
+	parameter gain (0, gain_desc);
+	size_t calls = 0u;
+	parameter::param_value last_value = -1.;
+	auto token = gain.add_listener ([&] (auto&, auto v) {
+		++calls;
+		last_value = v;
+	});
+	gain.setNormalized (0.25);
+	EXPECT_EQ (calls, 1u);
+	EXPECT_EQ (last_value, 0.25);
+
+	gain.remove_listener (token);
+	gain.setNormalized (0.5);
+	EXPECT_EQ (calls, 1u);
+
+	// removing a listener from within a listener
+	token = gain.add_listener ([&] (auto& p, auto) {
+		++calls;
+		p.remove_listener (token);
+	});
+	gain.setNormalized (0.75);
+	gain.setNormalized (1.);
+	EXPECT_EQ (calls, 2u);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_test, notification_batcher)
+{
+	notification_batcher batcher;
+	auto gain = std::make_unique<parameter> (0, gain_desc);
+	parameter mode (1, mode_desc);
+	size_t gain_calls = 0u;
+	size_t mode_calls = 0u;
+	parameter::param_value last_value = -1.;
+	gain->add_listener ([&] (auto&, auto v) {
+		++gain_calls;
+		last_value = v;
+	});
+	mode.add_listener ([&] (auto&, auto) { ++mode_calls; });
+	gain->set_notification_batcher (&batcher);
+	mode.set_notification_batcher (&batcher);
+
+	gain->setNormalized (0.25);
+	gain->setNormalized (0.5);
+	mode.setNormalized (0.);
+	EXPECT_EQ (gain_calls, 0u);
+	EXPECT_EQ (batcher.size (), 2u);
+
+	batcher.flush ();
+	EXPECT_TRUE (batcher.empty ());
+	EXPECT_EQ (gain_calls, 1u);
+	EXPECT_EQ (mode_calls, 1u);
+	EXPECT_EQ (last_value, 0.5);
+
+	batcher.flush ();
+	EXPECT_EQ (gain_calls, 1u);
+
+	// a destroyed parameter is removed from the batcher
+	gain->setNormalized (0.75);
+	gain.reset ();
+	EXPECT_TRUE (batcher.empty ());
+
+	// removing the batcher delivers the pending notification
+	mode.setNormalized (1.);
+	mode.set_notification_batcher (nullptr);
+	EXPECT_EQ (mode_calls, 2u);
+	EXPECT_TRUE (batcher.empty ());
+	mode.setNormalized (0.);
+	EXPECT_EQ (mode_calls, 3u);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_test, notification_batcher_destroy_during_flush)
+{
+	notification_batcher batcher;
+	parameter gain (0, gain_desc);
+	auto mode = std::make_unique<parameter> (1, mode_desc);
+	auto band = std::make_unique<parameter> (2, mode_desc);
+	size_t mode_calls = 0u;
+	size_t band_calls = 0u;
+	gain.add_listener ([&] (auto&, auto) {
+		mode.reset ();
+		band->set_notification_batcher (nullptr);
+	});
+	mode->add_listener ([&] (auto&, auto) { ++mode_calls; });
+	band->add_listener ([&] (auto&, auto) { ++band_calls; });
+	gain.set_notification_batcher (&batcher);
+	mode->set_notification_batcher (&batcher);
+	band->set_notification_batcher (&batcher);
+
+	gain.setNormalized (0.25);
+	mode->setNormalized (0.);
+	band->setNormalized (0.);
+	EXPECT_EQ (batcher.size (), 3u);
+
+	// the listener of gain destroys mode and detaches band while both are still waiting
+	batcher.flush ();
+	EXPECT_TRUE (batcher.empty ());
+	EXPECT_EQ (mode_calls, 0u);
+	EXPECT_EQ (band_calls, 1u);
+}
+
+//------------------------------------------------------------------------
+TEST (parameter_test, custom_functions)
+{
+	parameter gain (0, gain_desc);
+	EXPECT_DOUBLE_EQ (gain.toPlain (1.), 12.);
+	gain.set_custom_to_plain_func ([] (const auto&, auto v) { return v * 2.; });
+	gain.set_custom_to_normalized_func ([] (const auto&, auto v) { return v * 0.5; });
+	EXPECT_DOUBLE_EQ (gain.toPlain (1.), 2.);
+	EXPECT_DOUBLE_EQ (gain.toNormalized (1.), 0.5);
+	gain.set_custom_to_plain_func ({});
+	EXPECT_DOUBLE_EQ (gain.toPlain (1.), 12.);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/preset_loader.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+using namespace Steinberg;
+
+//------------------------------------------------------------------------
+struct memory_stream : IBStream
+{
+	tresult PLUGIN_API queryInterface (const TUID, void**) override { return kNotImplemented; }
+	uint32 PLUGIN_API addRef () override { return 1; }
+	uint32 PLUGIN_API release () override { return 1; }
+
+	tresult PLUGIN_API read (void* buffer, int32 numBytes, int32* numBytesRead) override
+	{
+		auto n = std::min (static_cast<size_t> (numBytes), data.size () - pos);
+		std::copy_n (data.data () + pos, n, static_cast<uint8_t*> (buffer));
+		pos += n;
+		if (numBytesRead)
+			*numBytesRead = static_cast<int32> (n);
+		return kResultTrue;
+	}
+	tresult PLUGIN_API write (void* buffer, int32 numBytes, int32* numBytesWritten) override
+	{
+		auto src = static_cast<const uint8_t*> (buffer);
+		data.insert (data.end (), src, src + numBytes);
+		if (numBytesWritten)
+			*numBytesWritten = numBytes;
+		return kResultTrue;
+	}
+	tresult PLUGIN_API seek (int64, int32, int64*) override { return kNotImplemented; }
+	tresult PLUGIN_API tell (int64*) override { return kNotImplemented; }
+
+	std::vector<uint8_t> data;
+	size_t pos {0u};
+};
+
+//------------------------------------------------------------------------
+static const param::description desc =
+	param::range_description (u"value", 0., param::linear_functions<0, 1> ());
+
+//------------------------------------------------------------------------
+struct preset_loader_test : ::testing::Test
+{
+	preset_loader_test ()
+	{
+		for (auto i = 0u; i < parameters.size (); ++i)
+		{
+			parameters[i] = std::make_unique<parameter> (i, desc);
+			pointers[i] = parameters[i].get ();
+		}
+		// only the first two parameters have listeners
+		for (auto i = 0u; i < 2u; ++i)
+		{
+			parameters[i]->add_listener ([this] (auto&, auto) {
+				++calls;
+				// all values of the preset are set when the listeners are called
+				values_seen = {pointers[0]->getNormalized (), pointers[1]->getNormalized (),
+							   pointers[2]->getNormalized (), pointers[3]->getNormalized ()};
+			});
+		}
+	}
+
+	std::array<std::unique_ptr<parameter>, 4> parameters;
+	std::array<parameter*, 4> pointers {};
+	std::array<double, 4> values_seen {};
+	size_t calls {0u};
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_F (preset_loader_test, apply_values)
+{
+	preset_loader loader;
+	std::array<double, 4> preset = {0.5, 0., 0.25, 1.};
+	EXPECT_EQ (loader.apply (pointers.data (), preset.data (), preset.size ()), 3u);
+	EXPECT_EQ (loader.changed (), (std::vector<uint32_t> {0, 2, 3}));
+	EXPECT_EQ (calls, 1u);
+	EXPECT_EQ (values_seen, preset);
+	for (auto i = 0u; i < preset.size (); ++i)
+		EXPECT_EQ (pointers[i]->getNormalized (), preset[i]);
+
+	// listeners are called directly again after apply
+	pointers[1]->setNormalized (0.75);
+	EXPECT_EQ (calls, 2u);
+
+	EXPECT_EQ (loader.apply (pointers.data (), preset.data (), preset.size ()), 1u);
+	EXPECT_EQ (loader.changed (), (std::vector<uint32_t> {1}));
+	EXPECT_EQ (calls, 3u);
+}
+
+//------------------------------------------------------------------------
+TEST_F (preset_loader_test, apply_stream)
+{
+	memory_stream memory;
+	auto stream = make_byte_order_stream<byte_order::little_endian> (IPtr<IBStream> (&memory));
+	std::array<double, 4> preset = {1., 1., 0.5, 0.};
+	stream.write (preset.data (), preset.size ());
+
+	preset_loader loader;
+	EXPECT_TRUE (loader.apply (pointers.data (), pointers.size (), stream));
+	EXPECT_EQ (loader.changed (), (std::vector<uint32_t> {0, 1, 2}));
+	EXPECT_EQ (calls, 2u);
+	EXPECT_EQ (values_seen, preset);
+
+	// not enough data
+	EXPECT_FALSE (loader.apply (pointers.data (), pointers.size (), stream));
+	EXPECT_EQ (calls, 2u);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
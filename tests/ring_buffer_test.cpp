@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/ring_buffer.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+struct ring_buffer_test : ::testing::TestWithParam<bool>
+{
+};
+
+//------------------------------------------------------------------------
+TEST_P (ring_buffer_test, push)
+{
+	ring_buffer<float> ring (100, GetParam ());
+	ASSERT_GE (ring.capacity (), 100);
+	if (!GetParam ())
+	{
+		EXPECT_FALSE (ring.is_mirrored ());
+		EXPECT_EQ (ring.capacity (), 100);
+	}
+	EXPECT_EQ (ring[1], 0.f);
+	for (auto i = 0u; i < ring.capacity () * 2u + 3u; ++i)
+		ring.push (static_cast<float> (i));
+	auto last = static_cast<float> (ring.capacity () * 2u + 2u);
+	EXPECT_EQ (ring[1], last);
+	EXPECT_EQ (ring[2], last - 1.f);
+	EXPECT_EQ (ring[ring.capacity ()], last - static_cast<float> (ring.capacity () - 1u));
+}
+
+//------------------------------------------------------------------------
+TEST_P (ring_buffer_test, contiguous_read)
+{
+	ring_buffer<double> ring (64, GetParam ());
+	const auto capacity = ring.capacity ();
+	std::vector<double> block (capacity / 3u);
+	double counter = 0.;
+	for (auto round = 0u; round < 10u; ++round)
+	{
+		for (auto& v : block)
+			v = ++counter;
+		ring.write (block.data (), block.size ());
+
+		// the whole ring can be read from the oldest sample without wrap around handling
+		auto ptr = ring.read_ptr (capacity);
+		for (auto i = 0u; i < capacity; ++i)
+		{
+			auto expected = counter - static_cast<double> (capacity - 1u - i);
+			EXPECT_EQ (ptr[i], expected < 1. ? 0. : expected);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_P (ring_buffer_test, delay_line)
+{
+	ring_buffer<float> ring (40, GetParam ());
+	constexpr auto delay = 7u;
+	constexpr auto block_size = 16u;
+	float in[block_size];
+	float counter = 0.f;
+	for (auto round = 0u; round < 20u; ++round)
+	{
+		for (auto& v : in)
+			v = ++counter;
+		ring.write (in, block_size);
+		auto out = ring.read_ptr (delay + block_size);
+		for (auto i = 0u; i < block_size; ++i)
+		{
+			auto expected = in[i] - static_cast<float> (delay);
+			EXPECT_EQ (out[i], expected < 1.f ? 0.f : expected);
+		}
+	}
+	ring.clear ();
+	EXPECT_EQ (ring[1], 0.f);
+}
+
+INSTANTIATE_TEST_SUITE_P (mirroring, ring_buffer_test, ::testing::Bool ());
+
+//------------------------------------------------------------------------
+} // vst3utils
@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/smooth_value.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+TEST (smooth_value_test, process)
+{
+	smooth_value<double> v (0., 0.5);
+	v = 1.;
+	EXPECT_DOUBLE_EQ (v.process (), 0.5);
+	EXPECT_DOUBLE_EQ (v.process (), 0.75);
+	v.flush ();
+	EXPECT_DOUBLE_EQ (*v, 1.);
+}
+
+//------------------------------------------------------------------------
+template<typename T>
+struct smooth_value_block_test : ::testing::Test
+{
+};
+
+using sample_types = ::testing::Types<float, double>;
+TYPED_TEST_SUITE (smooth_value_block_test, sample_types);
+
+//------------------------------------------------------------------------
+TYPED_TEST (smooth_value_block_test, process_block)
+{
+	using T = TypeParam;
+	smooth_value<T> per_sample (static_cast<T> (0.2), static_cast<T> (0.01));
+	smooth_value<T> block (static_cast<T> (0.2), static_cast<T> (0.01));
+	per_sample = static_cast<T> (0.9);
+	block = static_cast<T> (0.9);
+
+	std::vector<T> out (37);
+	for (auto round = 0; round < 5; ++round)
+	{
+		block.process_block (out.data (), out.size ());
+		for (auto i = 0u; i < out.size (); ++i)
+			EXPECT_NEAR (out[i], per_sample.process (), 1e-5);
+		EXPECT_NEAR (*block, *per_sample, 1e-5);
+	}
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (smooth_value_block_test, apply_gain_block)
+{
+	using T = TypeParam;
+	smooth_value<T> per_sample (static_cast<T> (1), static_cast<T> (0.05));
+	smooth_value<T> block (static_cast<T> (1), static_cast<T> (0.05));
+	per_sample = static_cast<T> (0);
+	block = static_cast<T> (0);
+
+	std::vector<T> io (29, static_cast<T> (0.5));
+	block.apply_gain_block (io.data (), io.size ());
+	for (auto i = 0u; i < io.size (); ++i)
+		EXPECT_NEAR (io[i], static_cast<T> (0.5) * per_sample.process (), 1e-5);
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (smooth_value_block_test, converged)
+{
+	using T = TypeParam;
+	smooth_value<T> v (static_cast<T> (0.3), static_cast<T> (0.5));
+	std::vector<T> out (19, static_cast<T> (2));
+	v.apply_gain_block (out.data (), out.size ());
+	for (auto el : out)
+		EXPECT_EQ (el, static_cast<T> (0.6));
+	v = static_cast<T> (0.7);
+	for (auto round = 0; round < 100; ++round)
+		v.process_block (out.data (), out.size ());
+	EXPECT_EQ (*v, static_cast<T> (0.7));
+	for (auto el : out)
+		EXPECT_EQ (el, static_cast<T> (0.7));
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (smooth_value_block_test, bank_process)
+{
+	using T = TypeParam;
+	constexpr size_t num = 13u;
+	smooth_value_bank<T, num> bank (static_cast<T> (0.1), static_cast<T> (1e-6));
+	std::vector<smooth_value<T>> reference (num);
+	EXPECT_TRUE (bank.all_settled ());
+	for (auto i = 0u; i < num; ++i)
+	{
+		auto alpha = static_cast<T> (0.01) * static_cast<T> (i + 1);
+		bank.set_alpha (i, alpha);
+		reference[i].set_alpha (alpha);
+	}
+	for (auto i = 0u; i < num; i += 2)
+	{
+		bank.set (i, static_cast<T> (1));
+		reference[i] = static_cast<T> (1);
+	}
+	EXPECT_FALSE (bank.all_settled ());
+	EXPECT_FALSE (bank.is_settled (0));
+	EXPECT_TRUE (bank.is_settled (1));
+	for (auto s = 0; s < 50; ++s)
+	{
+		bank.process ();
+		for (auto i = 0u; i < num; ++i)
+			EXPECT_NEAR (bank.smoothed_value (i), reference[i].process (), 1e-5);
+	}
+	auto samples = 0;
+	while (!bank.all_settled ())
+	{
+		bank.process ();
+		ASSERT_LT (++samples, 100000);
+	}
+	for (auto i = 0u; i < num; ++i)
+		EXPECT_EQ (bank.smoothed_value (i), bank.get (i));
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (smooth_value_block_test, bank_process_keeps_settled_values)
+{
+	using T = TypeParam;
+	smooth_value_bank<T, 2> bank (static_cast<T> (0.1));
+	const auto settled_value = static_cast<T> (0.0137);
+	bank.set_flushed (0, settled_value);
+	bank.set (1, static_cast<T> (1));
+	for (auto s = 0; s < 1000; ++s)
+	{
+		bank.process ();
+		ASSERT_TRUE (bank.is_settled (0));
+		ASSERT_EQ (bank.smoothed_value (0), settled_value);
+		bank.set (1, static_cast<T> (s & 1));
+	}
+}
+
+//------------------------------------------------------------------------
+TYPED_TEST (smooth_value_block_test, bank_advance)
+{
+	using T = TypeParam;
+	smooth_value_bank<T, 70> bank (static_cast<T> (0.05));
+	smooth_value<T> reference (static_cast<T> (0), static_cast<T> (0.05));
+	bank.set (69, static_cast<T> (2));
+	reference = static_cast<T> (2);
+	bank.advance (10);
+	for (auto i = 0; i < 10; ++i)
+		reference.process ();
+	EXPECT_NEAR (bank.smoothed_value (69), *reference, 1e-5);
+	EXPECT_EQ (bank.smoothed_value (68), static_cast<T> (0));
+
+	std::vector<T> out (16);
+	bank.process_block (69, out.data (), out.size ());
+	for (auto el : out)
+		EXPECT_NEAR (el, reference.process (), 1e-5);
+
+	bank.advance (100000);
+	EXPECT_TRUE (bank.all_settled ());
+	EXPECT_EQ (bank.smoothed_value (69), static_cast<T> (2));
+}
+
+//------------------------------------------------------------------------
+TEST (timed_smooth_value_test, alpha_for_time)
+{
+	EXPECT_DOUBLE_EQ (timed_smooth_value<double>::alpha_for_time (0., 48000.), 1.);
+	auto alpha = timed_smooth_value<double>::alpha_for_time (10., 48000.);
+	EXPECT_NEAR (alpha, 1. - std::exp (-1. / 480.), 1e-12);
+	// the same time results in the same smoothing curve at any sample rate
+	smooth_value<double> v44 (0., timed_smooth_value<double>::alpha_for_time (10., 44100.));
+	smooth_value<double> v88 (0., timed_smooth_value<double>::alpha_for_time (10., 88200.));
+	v44 = 1.;
+	v88 = 1.;
+	for (auto i = 0; i < 441; ++i)
+	{
+		v44.process ();
+		v88.process ();
+		v88.process ();
+	}
+	EXPECT_NEAR (*v44, *v88, 1e-3);
+	EXPECT_NEAR (*v44, 1. - std::exp (-1.), 1e-3);
+}
+
+//------------------------------------------------------------------------
+TEST (timed_smooth_value_test, settle)
+{
+	timed_smooth_value<float> v (0.f, 1.f, 48000., 1e-4f);
+	EXPECT_TRUE (v.is_settled ());
+	v = 0.f;
+	EXPECT_TRUE (v.is_settled ());
+	v = 1.f;
+	EXPECT_FALSE (v.is_settled ());
+	auto samples = 0;
+	while (!v.is_settled ())
+	{
+		v.process ();
+		++samples;
+		ASSERT_LT (samples, 48000);
+	}
+	// 1ms time constant at 48kHz settles within 1e-4 after ln (1e4) * 48 samples
+	EXPECT_NEAR (samples, std::log (1e4) * 48., 2.);
+	EXPECT_EQ (*v, 1.f);
+	EXPECT_EQ (v.process (), 1.f);
+}
+
+//------------------------------------------------------------------------
+TEST (timed_smooth_value_test, settle_slow_float)
+{
+	// the float one-pole stops moving before it is within epsilon of the value
+	timed_smooth_value<float> v (0.f, 100.f, 48000., 1e-7f);
+	v = 1.f;
+	auto samples = 0;
+	while (!v.is_settled ())
+	{
+		v.process ();
+		ASSERT_LT (++samples, 48000 * 10);
+	}
+	EXPECT_EQ (*v, 1.f);
+}
+
+//------------------------------------------------------------------------
+TEST (timed_smooth_value_test, settle_block)
+{
+	timed_smooth_value<double> v (1., 2., 44100.);
+	v = 0.5;
+	std::vector<double> out (64);
+	auto blocks = 0;
+	while (!v.is_settled ())
+	{
+		v.process_block (out.data (), out.size ());
+		ASSERT_LT (++blocks, 1000);
+	}
+	EXPECT_EQ (*v, 0.5);
+	v.process_block (out.data (), out.size ());
+	for (auto el : out)
+		EXPECT_EQ (el, 0.5);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
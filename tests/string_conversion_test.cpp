@@ -26,6 +26,19 @@ TEST (string_conversion_test, copy_utf16_to_ascii)
 	EXPECT_EQ (result, "This is a string with * few un*code ch*ract*rs");
 }
 
+//------------------------------------------------------------------------
+TEST (string_conversion_test, copy_utf16_to_ascii_buffer)
+{
+	auto utfStr = u"A string with á unícode chäractér";
+	char result[64];
+	auto length = copy_utf16_to_ascii (utfStr, std::begin (result), std::end (result));
+	EXPECT_EQ (std::string (result, length), "A string with  uncode chractr");
+
+	char small[8];
+	length = copy_utf16_to_ascii (utfStr, std::begin (small), std::end (small));
+	EXPECT_EQ (std::string (small, length), "A string");
+}
+
 //------------------------------------------------------------------------
 TEST (string_conversion_test, create_utf16_from_ascii)
 {
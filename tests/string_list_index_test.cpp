@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/string_list_index.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <string>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+
+//------------------------------------------------------------------------
+TEST (string_list_index_test, find)
+{
+	static constexpr std::array strings = {u"saw", u"square", u"sine", u"noise", u"sine", u""};
+	string_list_index index (strings.data (), strings.size ());
+	EXPECT_EQ (index.size (), strings.size ());
+	EXPECT_EQ (index.find (u"saw"), 0);
+	EXPECT_EQ (index.find (u"square"), 1);
+	EXPECT_EQ (index.find (u"noise"), 3);
+	// the first of equal strings is found
+	EXPECT_EQ (index.find (u"sine"), 2);
+	EXPECT_EQ (index.find (u""), 5);
+	EXPECT_EQ (index.find (u"sin"), -1);
+	EXPECT_EQ (index.find (u"triangle"), -1);
+}
+
+//------------------------------------------------------------------------
+TEST (string_list_index_test, large_list)
+{
+	constexpr size_t num = 5000u;
+	std::vector<std::u16string> storage;
+	std::vector<const char16_t*> strings;
+	for (size_t i = 0u; i < num; ++i)
+	{
+		auto ascii = "sample " + std::to_string ((i * 7919u) % num);
+		storage.emplace_back (ascii.begin (), ascii.end ());
+	}
+	for (const auto& s : storage)
+		strings.push_back (s.data ());
+
+	string_list_index index (strings.data (), strings.size ());
+	for (size_t i = 0u; i < num; ++i)
+		EXPECT_EQ (index.find (storage[i]), static_cast<int32_t> (i));
+	EXPECT_EQ (index.find (u"sample 5000"), -1);
+}
+
+//------------------------------------------------------------------------
+TEST (string_list_index_test, shared)
+{
+	static constexpr std::array strings = {u"off", u"on"};
+	const auto& index = string_list_index::get (strings.data (), strings.size ());
+	EXPECT_EQ (&string_list_index::get (strings.data (), strings.size ()), &index);
+	EXPECT_EQ (index.find (u"on"), 1);
+}
+
+//------------------------------------------------------------------------
+TEST (string_list_index_test, shared_with_different_sizes)
+{
+	static constexpr std::array strings = {u"low", u"mid", u"high"};
+	const auto& all = string_list_index::get (strings.data (), 3u);
+	const auto& first_two = string_list_index::get (strings.data (), 2u);
+	EXPECT_NE (&all, &first_two);
+	EXPECT_EQ (all.find (u"high"), 2);
+	EXPECT_EQ (first_two.size (), 2u);
+	EXPECT_EQ (first_two.find (u"high"), -1);
+	EXPECT_EQ (first_two.find (u"mid"), 1);
+}
+
+//------------------------------------------------------------------------
+} // vst3utils
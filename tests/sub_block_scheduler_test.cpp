@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------
+/* This source code is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://sam.zoy.org/wtfpl/COPYING for more details. */
+//------------------------------------------------------------------------
+
+#include "vst3utils/sub_block_scheduler.h"
+#include "public.sdk/source/vst/hosting/eventlist.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace vst3utils {
+namespace {
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+//------------------------------------------------------------------------
+void add_note_on (EventList& events, int32 sample_offset, int16 pitch)
+{
+	Event e {};
+	e.type = Event::kNoteOnEvent;
+	e.sampleOffset = sample_offset;
+	e.noteOn.pitch = pitch;
+	events.addEvent (e);
+}
+
+//------------------------------------------------------------------------
+struct recorded_block
+{
+	int32 start;
+	int32 num_samples;
+	std::vector<ParamID> pids;
+	std::vector<int16> pitches;
+
+	bool operator== (const recorded_block& o) const
+	{
+		return start == o.start && num_samples == o.num_samples && pids == o.pids &&
+			   pitches == o.pitches;
+	}
+};
+
+//------------------------------------------------------------------------
+std::vector<recorded_block> run (sub_block_scheduler& scheduler, IParameterChanges* changes,
+								 IEventList* events, int32 num_samples)
+{
+	std::vector<recorded_block> result;
+	scheduler.process (changes, events, num_samples,
+					   [&] (const sub_block_scheduler::sub_block& block) {
+						   recorded_block rec {block.start, block.num_samples, {}, {}};
+						   for (size_t i = 0u; i < block.num_changes (); ++i)
+							   rec.pids.push_back (block.pid (i));
+						   for (size_t i = 0u; i < block.num_events; ++i)
+							   rec.pitches.push_back (block.events[i].noteOn.pitch);
+						   result.push_back (rec);
+					   });
+	return result;
+}
+
+//------------------------------------------------------------------------
+void add_changes (ParameterChanges& changes)
+{
+	int32 index;
+	auto queue = changes.addParameterData (7, index);
+	queue->addPoint (0, 0.1, index);
+	queue->addPoint (40, 0.2, index);
+	changes.addParameterData (3, index)->addPoint (10, 0.3, index);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+using blocks = std::vector<recorded_block>;
+
+//------------------------------------------------------------------------
+TEST (sub_block_scheduler_test, no_changes)
+{
+	sub_block_scheduler scheduler;
+	scheduler.setup (16, 16);
+	EXPECT_EQ (run (scheduler, nullptr, nullptr, 64), (blocks {{0, 64, {}, {}}}));
+	EXPECT_TRUE (run (scheduler, nullptr, nullptr, 0).empty ());
+}
+
+//------------------------------------------------------------------------
+TEST (sub_block_scheduler_test, split_at_every_offset)
+{
+	ParameterChanges changes;
+	add_changes (changes);
+	EventList events;
+	add_note_on (events, 20, 60);
+	sub_block_scheduler scheduler;
+	scheduler.setup (16, 16);
+	EXPECT_EQ (run (scheduler, &changes, &events, 64), (blocks {
+														   {0, 10, {7}, {}},
+														   {10, 10, {3}, {}},
+														   {20, 20, {}, {60}},
+														   {40, 24, {7}, {}},
+													   }));
+}
+
+//------------------------------------------------------------------------
+TEST (sub_block_scheduler_test, min_sub_block_size)
+{
+	ParameterChanges changes;
+	add_changes (changes);
+	EventList events;
+	add_note_on (events, 20, 60);
+	add_note_on (events, 60, 62);
+	sub_block_scheduler scheduler;
+	scheduler.setup (16, 16, 16);
+	EXPECT_EQ (run (scheduler, &changes, &events, 64), (blocks {
+														   {0, 20, {7, 3}, {}},
+														   {20, 20, {}, {60}},
+														   {40, 20, {7}, {}},
+														   {60, 4, {}, {62}},
+													   }));
+	// everything after the end of the block is applied in the last sub-block
+	EXPECT_EQ (run (scheduler, &changes, &events, 8), (blocks {{0, 8, {7, 3, 7}, {60, 62}}}));
+}
+
+//------------------------------------------------------------------------
+TEST (sub_block_scheduler_test, unsorted_events)
+{
+	EventList events;
+	add_note_on (events, 30, 1);
+	add_note_on (events, 10, 2);
+	add_note_on (events, 30, 3);
+	sub_block_scheduler scheduler;
+	scheduler.setup (0, 16);
+	EXPECT_EQ (run (scheduler, nullptr, &events, 32), (blocks {
+														  {0, 10, {}, {}},
+														  {10, 20, {}, {2}},
+														  {30, 2, {}, {1, 3}},
+													  }));
+}
+
+//------------------------------------------------------------------------
+TEST (sub_block_scheduler_test, flush)
+{
+	ParameterChanges changes;
+	add_changes (changes);
+	sub_block_scheduler scheduler;
+	scheduler.setup (16, 16);
+	EXPECT_EQ (run (scheduler, &changes, nullptr, 0), (blocks {{0, 0, {7, 3, 7}, {}}}));
+}
+
+//------------------------------------------------------------------------
+TEST (sub_block_scheduler_test, capacity)
+{
+	ParameterChanges changes;
+	add_changes (changes);
+	EventList events;
+	add_note_on (events, 20, 60);
+	add_note_on (events, 30, 62);
+	sub_block_scheduler scheduler;
+	scheduler.setup (2, 1);
+	EXPECT_FALSE (scheduler.process (&changes, &events, 64, [] (const auto&) {}));
+	EXPECT_EQ (run (scheduler, &changes, &events, 64), (blocks {
+														   {0, 20, {7}, {}},
+														   {20, 20, {}, {60}},
+														   {40, 24, {7}, {}},
+													   }));
+}
+
+//------------------------------------------------------------------------
+} // vst3utils